@@ -0,0 +1,31 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------
+# 'DoTrackCutStudyBenchmark.sh'
+# Derek Anderson
+# 10.18.2026
+#
+# A script to generate synthetic tuples (if
+# they don't exist yet) and then run
+# 'DoTrackCutStudyBenchmark.C' on them.
+#
+# Usage: ./DoTrackCutStudyBenchmark.sh [no. of events] [label]
+# -----------------------------------------------------------------------------
+
+nEvents=${1:-10000}
+label=${2:-default}
+
+# synthetic inputs
+fileEO="syntheticTuples.embedOnly.n${nEvents}.root"
+filePU="syntheticTuples.withPileup.n${nEvents}.root"
+
+if [ ! -f $fileEO ]; then
+  root -b -q "macros/MakeSyntheticTuples.C(\"$fileEO\", $nEvents, 20., 0.)"
+fi
+if [ ! -f $filePU ]; then
+  root -b -q "macros/MakeSyntheticTuples.C(\"$filePU\", $nEvents, 5., 200., 0.05, 0.01, false, 2)"
+fi
+
+# run benchmark
+root -b -q "DoTrackCutStudyBenchmark.C(\"$fileEO\", \"$filePU\", true, 1, \"trackCutStudyBenchmark.csv\", \"$label\")"
+
+# end -------------------------------------------------------------------------
@@ -0,0 +1,150 @@
+// ----------------------------------------------------------------------------
+// 'DatasetCatalog.h'
+// Derek Anderson
+// 10.18.2026
+//
+// Reading/writing the dataset catalog made by
+// 'BuildDatasetCatalog.C'.  The catalog is a
+// small tree with one entry per input file:
+// its size, mtime, md5, and for each evaluator
+// tuple the no. of entries, bytes, branches,
+// and range of event IDs.
+// ----------------------------------------------------------------------------
+
+#ifndef DATASETCATALOG_H
+#define DATASETCATALOG_H
+
+#include <map>
+#include <string>
+#include <iostream>
+#include "TFile.h"
+#include "TTree.h"
+#include "TString.h"
+#include "TSystem.h"
+
+using namespace std;
+
+// catalogued tuples
+static const UInt_t  NCatTuple(3);
+static const TString SCatTuples[NCatTuple] = {"ntp_track", "ntp_gtrack", "ntp_cluster"};
+static const TString SCatTree("catalog");
+
+
+
+// one input file
+struct CatalogEntry {
+  string   path;
+  Long64_t size;
+  Long_t   mtime;
+  string   md5;
+  Bool_t   isReadable;           // false if file couldn't be opened
+  Long64_t nEntries[NCatTuple];  // -1 if tuple is missing
+  Long64_t nBytes[NCatTuple];    // compressed
+  Long64_t evtMin[NCatTuple];
+  Long64_t evtMax[NCatTuple];
+  string   branches[NCatTuple];  // comma-separated
+};
+
+
+
+// check if entry still describes the file on disk
+Bool_t IsCatalogEntryCurrent(const CatalogEntry &entry) {
+
+  FileStat_t stat;
+  if (gSystem -> GetPathInfo(entry.path.data(), stat) != 0) return false;
+  return ((stat.fSize == entry.size) && (stat.fMtime == entry.mtime));
+
+}  // end 'IsCatalogEntryCurrent(CatalogEntry&)'
+
+
+
+// read catalog into a map of path --> entry
+Bool_t ReadDatasetCatalog(const TString sCatalog, map<string, CatalogEntry> &entries) {
+
+  entries.clear();
+  if (gSystem -> AccessPathName(sCatalog.Data())) return false;
+
+  TFile *fCatalog = TFile::Open(sCatalog.Data(), "read");
+  if (!fCatalog || fCatalog -> IsZombie()) {
+    cerr << "WARNING: couldn't open catalog '" << sCatalog.Data() << "'!" << endl;
+    return false;
+  }
+
+  TTree *tCatalog = (TTree*) fCatalog -> Get(SCatTree.Data());
+  if (!tCatalog) {
+    cerr << "WARNING: no catalog tree in '" << sCatalog.Data() << "'!" << endl;
+    fCatalog -> Close();
+    return false;
+  }
+
+  CatalogEntry entry;
+  string *path = NULL;
+  string *md5  = NULL;
+  string *branches[NCatTuple] = {NULL, NULL, NULL};
+  tCatalog -> SetBranchAddress("path",     &path);
+  tCatalog -> SetBranchAddress("size",     &entry.size);
+  tCatalog -> SetBranchAddress("mtime",    &entry.mtime);
+  tCatalog -> SetBranchAddress("md5",      &md5);
+  tCatalog -> SetBranchAddress("readable", &entry.isReadable);
+  tCatalog -> SetBranchAddress("nEntries", entry.nEntries);
+  tCatalog -> SetBranchAddress("nBytes",   entry.nBytes);
+  tCatalog -> SetBranchAddress("evtMin",   entry.evtMin);
+  tCatalog -> SetBranchAddress("evtMax",   entry.evtMax);
+  for (UInt_t iTuple = 0; iTuple < NCatTuple; iTuple++) {
+    tCatalog -> SetBranchAddress(("branches_" + SCatTuples[iTuple]).Data(), &branches[iTuple]);
+  }
+
+  for (Long64_t iEntry = 0; iEntry < tCatalog -> GetEntries(); iEntry++) {
+    tCatalog -> GetEntry(iEntry);
+    entry.path = *path;
+    entry.md5  = *md5;
+    for (UInt_t iTuple = 0; iTuple < NCatTuple; iTuple++) {
+      entry.branches[iTuple] = *branches[iTuple];
+    }
+    entries[entry.path] = entry;
+  }
+  fCatalog -> Close();
+  return true;
+
+}  // end 'ReadDatasetCatalog(TString, map<string, CatalogEntry>&)'
+
+
+
+// write a map of path --> entry to a catalog
+void WriteDatasetCatalog(const TString sCatalog, const map<string, CatalogEntry> &entries) {
+
+  // write to a temporary so readers never see half a catalog
+  const TString sTemp = sCatalog + ".tmp";
+  TFile *fCatalog = new TFile(sTemp.Data(), "recreate");
+  TTree *tCatalog = new TTree(SCatTree.Data(), "Dataset catalog");
+
+  CatalogEntry entry;
+  const TString sArray = TString::Format("[%u]/L", NCatTuple);
+  tCatalog -> Branch("path",     &entry.path);
+  tCatalog -> Branch("size",     &entry.size,    "size/L");
+  tCatalog -> Branch("mtime",    &entry.mtime,   "mtime/L");
+  tCatalog -> Branch("md5",      &entry.md5);
+  tCatalog -> Branch("readable", &entry.isReadable, "readable/O");
+  tCatalog -> Branch("nEntries", entry.nEntries, ("nEntries" + sArray).Data());
+  tCatalog -> Branch("nBytes",   entry.nBytes,   ("nBytes"   + sArray).Data());
+  tCatalog -> Branch("evtMin",   entry.evtMin,   ("evtMin"   + sArray).Data());
+  tCatalog -> Branch("evtMax",   entry.evtMax,   ("evtMax"   + sArray).Data());
+  for (UInt_t iTuple = 0; iTuple < NCatTuple; iTuple++) {
+    tCatalog -> Branch(("branches_" + SCatTuples[iTuple]).Data(), &entry.branches[iTuple]);
+  }
+
+  for (const auto &saved : entries) {
+    entry = saved.second;
+    tCatalog -> Fill();
+  }
+  fCatalog -> cd();
+  tCatalog -> Write();
+  fCatalog -> Close();
+  gSystem  -> Rename(sTemp.Data(), sCatalog.Data());
+  return;
+
+}  // end 'WriteDatasetCatalog(TString, map<string, CatalogEntry>&)'
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,148 @@
+// ----------------------------------------------------------------------------
+// 'HistogramReaders.h'
+// Derek Anderson
+// 10.18.2026
+//
+// Helpers to read histograms out of the
+// track cut study output.  2D histograms
+// may have been saved as sparse histograms
+// (see 'STrackCutStudy::SetSparseOutput'),
+// so these hand back the dense version.  The
+// output may also hold pre-rebinned copies
+// (see 'STrackCutStudy::SetRebinPyramid'),
+// which 'GetRebinnedHist' reads from when it
+// can.
+//
+// 'STrackCutStudy' compiles this header too
+// (plot-only mode reads its own sparse output),
+// so the helpers are inline.
+// ----------------------------------------------------------------------------
+
+#ifndef HISTOGRAMREADERS_H
+#define HISTOGRAMREADERS_H
+
+#include <iostream>
+#include "TH1.h"
+#include "TH2.h"
+#include "TAxis.h"
+#include "TMath.h"
+#include "TString.h"
+#include "THnBase.h"
+#include "TDirectory.h"
+
+using namespace std;
+
+
+
+inline TH1* MakeDenseHist(const THnBase *hSparse) {
+
+  const Int_t nDim = hSparse -> GetNdimensions();
+  if ((nDim < 1) || (nDim > 2)) {
+    cerr << "WARNING: can't densify " << nDim << "D histogram '" << hSparse -> GetName() << "'!" << endl;
+    return NULL;
+  }
+
+  // make dense histogram with same binning
+  TAxis *xAxis = hSparse -> GetAxis(0);
+  TAxis *yAxis = (nDim > 1) ? hSparse -> GetAxis(1) : NULL;
+
+  TH1 *hDense = NULL;
+  if (nDim == 1) {
+    if (xAxis -> IsVariableBinSize()) {
+      hDense = new TH1D(hSparse -> GetName(), hSparse -> GetTitle(), xAxis -> GetNbins(), xAxis -> GetXbins() -> GetArray());
+    } else {
+      hDense = new TH1D(hSparse -> GetName(), hSparse -> GetTitle(), xAxis -> GetNbins(), xAxis -> GetXmin(), xAxis -> GetXmax());
+    }
+  } else {
+    hDense = new TH2D(hSparse -> GetName(), hSparse -> GetTitle(), xAxis -> GetNbins(), xAxis -> GetXmin(), xAxis -> GetXmax(), yAxis -> GetNbins(), yAxis -> GetXmin(), yAxis -> GetXmax());
+    if (xAxis -> IsVariableBinSize()) hDense -> GetXaxis() -> Set(xAxis -> GetNbins(), xAxis -> GetXbins() -> GetArray());
+    if (yAxis -> IsVariableBinSize()) hDense -> GetYaxis() -> Set(yAxis -> GetNbins(), yAxis -> GetXbins() -> GetArray());
+    hDense -> GetYaxis() -> SetTitle(yAxis -> GetTitle());
+  }
+  hDense -> GetXaxis() -> SetTitle(xAxis -> GetTitle());
+  hDense -> Sumw2();
+
+  // copy filled bins (including under/overflow)
+  Int_t iBin[2] = {0, 0};
+  for (Long64_t iFilled = 0; iFilled < hSparse -> GetNbins(); iFilled++) {
+    const Double_t content = hSparse -> GetBinContent(iFilled, iBin);
+    const Double_t error2  = hSparse -> GetBinError2(iFilled);
+    const Int_t    iCell   = (nDim == 1) ? hDense -> GetBin(iBin[0]) : hDense -> GetBin(iBin[0], iBin[1]);
+    hDense -> SetBinContent(iCell, content);
+    hDense -> SetBinError(iCell, TMath::Sqrt(error2));
+  }
+  hDense -> SetEntries(hSparse -> GetEntries());
+  return hDense;
+
+}  // end 'MakeDenseHist(THnBase*)'
+
+
+
+inline TH1* GetDenseHist(TDirectory *dInput, const TString sHist) {
+
+  TObject *obj = dInput -> Get(sHist.Data());
+  if (!obj) return NULL;
+
+  // dense histograms are passed through
+  if (obj -> InheritsFrom(TH1::Class())) return (TH1*) obj;
+
+  // sparse histograms are densified
+  if (obj -> InheritsFrom(THnBase::Class())) {
+    TH1 *hDense = MakeDenseHist((THnBase*) obj);
+    delete obj;
+    return hDense;
+  }
+
+  cerr << "WARNING: object '" << sHist.Data() << "' is not a histogram!" << endl;
+  return NULL;
+
+}  // end 'GetDenseHist(TDirectory*, TString)'
+
+
+
+inline TH1* GetRebinnedHist(TDirectory *dInput, const TString sHist, const UInt_t nRebin = 1) {
+
+  // split '<type>/<histogram>'
+  const Ssiz_t  iSlash = sHist.Last('/');
+  const TString sDir   = (iSlash == kNPOS) ? TString("") : TString(sHist(0, iSlash));
+  const TString sName  = (iSlash == kNPOS) ? sHist : TString(sHist(iSlash + 1, sHist.Length()));
+
+  // start from the coarsest saved level that divides the rebin factor
+  TH1   *hist   = NULL;
+  UInt_t nLevel = 1;
+  if ((nRebin > 1) && (sDir != "")) {
+    for (UInt_t nTry = nRebin; nTry > 1; nTry--) {
+      if ((nRebin % nTry) != 0) continue;
+
+      TString sLevel = sDir;
+      sLevel += "_Rebin";
+      sLevel += nTry;
+      TDirectory *dLevel = dInput -> GetDirectory(sLevel.Data());
+      if (!dLevel) continue;
+
+      hist = GetDenseHist(dLevel, sName);
+      if (hist) {
+        nLevel = nTry;
+        break;
+      }
+    }
+  }
+  if (!hist) hist = GetDenseHist(dInput, sHist);
+  if (!hist) return NULL;
+
+  // and finish the job
+  const UInt_t nLeft = nRebin / nLevel;
+  if (nLeft > 1) {
+    if (hist -> GetDimension() == 2) {
+      ((TH2*) hist) -> Rebin2D(nLeft, nLeft);
+    } else {
+      hist -> Rebin(nLeft);
+    }
+  }
+  return hist;
+
+}  // end 'GetRebinnedHist(TDirectory*, TString, UInt_t)'
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,19 @@
+# -----------------------------------------------------------------------------
+# 'ratioComparisons.spec'
+# Derek Anderson
+# 10.18.2026
+#
+# Example spec file for 'MakeBatchRatioPlots.C'.
+# One comparison per line, fields separated by
+# '|':
+#
+#   name | denominator file | denominator histogram | denominator label |
+#   numerator file | numerator histogram | numerator label | rebin |
+#   normalize (0/1) | x min | x max | x title | y title | ratio title
+# -----------------------------------------------------------------------------
+
+ptRecoAllVsCut   | trackCutStudy.pt020n20pim.root | AllTrack/hPt_AllTrack   | All tracks   | trackCutStudy.pt020n20pim.root | CutTrack/hPt_CutTrack  | Tracks after cuts | 5 | 0 | 0. | 20. | p_{T}^{reco} [GeV/c] | counts | cut / all
+etaAllVsCut      | trackCutStudy.pt020n20pim.root | AllTrack/hEta_AllTrack      | All tracks   | trackCutStudy.pt020n20pim.root | CutTrack/hEta_CutTrack     | Tracks after cuts | 2 | 0 | -2. | 2. | #eta^{reco}              | counts | cut / all
+ptRecoEOvsPU     | trackCutStudy.pt020n20pim.root | AllTrack/hPt_AllTrack   | Only #pi^{-} | trackCutStudy.pt020n5pim.pileup.root | AllTrack/hPt_AllTrack | With pileup | 10 | 1 | 0. | 20. | p_{T}^{reco} [GeV/c] | normalized counts | pileup / embed-only
+
+# end -------------------------------------------------------------------------
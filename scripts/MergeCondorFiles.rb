@@ -10,6 +10,18 @@
 
 # modules to use
 require 'fileutils'
+require_relative 'MergeManifest'
+require_relative 'MergeScheduler'
+
+# only merge files that aren't already in the output
+incremental = false
+
+# run chunk merges (and the final merge) side-by-side
+scheduled  = false
+max_cpus   = 16
+max_mem_gb = 32
+job_cpus   = 4
+job_mem_gb = 4
 
 # input parameters
 in_path = "./condor/individual_files/pp200py8jet10run6_trksAndChargPars_2023may7/"
@@ -21,6 +33,7 @@ out_pref = "correlatorJetTree.pp200py8jet10run6_trksAndChrgPars_"
 out_suff = ".d7m5y2023"
 out_root = ".root"
 out_list = ".list"
+out_all  = "0000to1999"
 
 # chunks to copy
 chunks = [
@@ -71,6 +84,7 @@ labels = [
 ]
 
 # create output arrays
+failed     = []
 num_chunks = chunks.size
 in_pattern = Array.new(num_chunks)
 list_files = Array.new(num_chunks)
@@ -94,6 +108,15 @@ chunks.each_with_index do |chunk, iChunk|
   root_files[iChunk].gsub!("//", "/")
   root_files[iChunk].gsub!("..", ".")
 
+  # scheduled merges are run after the loop
+  next if scheduled
+
+  # merge only new files (if needed)
+  if incremental
+    failed << labels[iChunk] unless MergeManifest.incremental_merge(Dir[in_pattern[iChunk]].sort, list_files[iChunk], root_files[iChunk])
+    next
+  end
+
   # create list of files in a chunk
   File.open(list_files[iChunk], "w") { |list|
     Dir[in_pattern[iChunk]].each do |file|
@@ -110,4 +133,25 @@ chunks.each_with_index do |chunk, iChunk|
 # end chunk loop
 end
 
+# merge chunks, then merge chunk outputs as soon as they're ready
+if scheduled
+  jobs = []
+  chunks.each_with_index do |chunk, iChunk|
+    jobs << MergeScheduler::Job.new(labels[iChunk], Dir[in_pattern[iChunk]].sort, root_files[iChunk], [], job_cpus, job_mem_gb)
+  end
+
+  all_file = out_pref + out_all + out_suff + out_root
+  all_file.gsub!("//", "/")
+  all_file.gsub!("..", ".")
+  jobs << MergeScheduler::Job.new(out_all, root_files.dup, all_file, labels.dup, job_cpus, job_mem_gb)
+
+  exit(MergeScheduler.run(jobs, max_cpus, max_mem_gb) ? 0 : 1)
+end
+
+# report chunks that didn't merge
+unless failed.empty?
+  STDERR.puts "WARNING: couldn't merge chunks #{failed.join(", ")}!"
+  exit(1)
+end
+
 # end -------------------------------------------------------------------------
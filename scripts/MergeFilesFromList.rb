@@ -11,11 +11,22 @@
 
 # modules to use
 require 'fileutils'
+require_relative 'MergeManifest'
+
+# only merge files that aren't already in the output
+incremental = false
 
 # i/o parameters
 in_list  = "checkingTrackTuples.goodFiles_embedOnly0200s.run6n100pt2040pim.d8m5y2023.list"
 out_file = "sPhenixG4_forPtCheck_embedOnly0200s_goodFiles_g4svtxeval.run6n100pt2040pim.d8m5y2023.root"
 
+# merge only new files (if needed)
+if incremental
+  in_files  = File.readlines(in_list).map(&:strip).reject(&:empty?)
+  work_list = out_file.sub(/\.root$/, "") + ".incremental.list"
+  exit(MergeManifest.incremental_merge(in_files, work_list, out_file) ? 0 : 1)
+end
+
 # count how many files there are
 num_files = 0
 File.open(in_list) { |list|
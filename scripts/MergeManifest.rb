@@ -0,0 +1,193 @@
+#!/usr/bin/env ruby
+# -----------------------------------------------------------------------------
+# 'MergeManifest.rb'
+# Derek Anderson
+# 10.18.2026
+#
+# Helpers for incremental merging with 'MergeFiles.C'.
+# Next to each merged file a manifest ('<file>.manifest')
+# lists the inputs already in it (path, size, mtime, md5),
+# so only new inputs need to be merged in later.
+# -----------------------------------------------------------------------------
+
+# modules to use
+require 'digest'
+require 'fileutils'
+
+module MergeManifest
+
+  # manifest entry
+  Entry = Struct.new(:path, :size, :mtime, :md5)
+
+  # manifest sits next to the merged file
+  def self.manifest_path(out_file)
+    return out_file + ".manifest"
+  end
+
+  # read manifest (path --> entry)
+  def self.load(out_file)
+    entries = {}
+    manifest = manifest_path(out_file)
+    return entries unless File.exist?(manifest) && File.exist?(out_file)
+
+    File.foreach(manifest) do |line|
+      next if line.start_with?("#") || line.strip.empty?
+      path, size, mtime, md5 = line.chomp.split("\t")
+      entries[path] = Entry.new(path, size.to_i, mtime.to_i, md5)
+    end
+    return entries
+  end
+
+  # write manifest (via a temporary so a crash never leaves half of one)
+  def self.save(out_file, entries)
+    manifest = manifest_path(out_file)
+    File.open(manifest + ".tmp", "w") { |out|
+      out.puts "# path\tsize\tmtime\tmd5"
+      entries.each_value do |entry|
+        out.puts [entry.path, entry.size, entry.mtime, entry.md5].join("\t")
+      end
+    }
+    FileUtils.mv(manifest + ".tmp", manifest)
+  end
+
+  # describe an input on disk
+  def self.describe(path)
+    stat = File.stat(path)
+    return Entry.new(path, stat.size, stat.mtime.to_i, Digest::MD5.file(path).hexdigest)
+  end
+
+  # sort inputs into what's already merged, what's new, and what's
+  # changed since it was merged; checksums are only computed for
+  # files that aren't already known with the same size and mtime
+  def self.plan(out_file, inputs)
+    known   = load(out_file)
+    by_md5  = {}
+    known.each_value { |entry| by_md5[entry.md5] = entry.path }
+
+    plan = { :merged => [], :new => [], :changed => [], :duplicates => [] }
+    seen = {}
+    inputs.each do |path|
+      path = File.expand_path(path)
+      if seen[path]
+        plan[:duplicates] << [path, path]
+        next
+      end
+      seen[path] = true
+
+      stat = File.stat(path)
+      old  = known[path]
+      if old && old.size == stat.size && old.mtime == stat.mtime.to_i
+        plan[:merged] << old
+        next
+      end
+
+      entry = describe(path)
+      if old
+        if old.md5 == entry.md5
+          plan[:merged] << entry
+        else
+          plan[:changed] << entry
+        end
+      elsif by_md5[entry.md5]
+        plan[:duplicates] << [path, by_md5[entry.md5]]
+      else
+        by_md5[entry.md5] = path
+        plan[:new] << entry
+      end
+    end
+    return plan
+  end
+
+  # 'MergeFiles.C' reports problems with a PANIC but still
+  # exits cleanly, so a merge only counts if it left an
+  # output behind and didn't panic
+  def self.merge_ok?(out_file, log_text)
+    return false if log_text.include?("PANIC")
+    return File.exist?(out_file) && File.size(out_file) > 0
+  end
+
+  # run 'MergeFiles.C' on a list of files
+  def self.run_merge(files, list_file, out_file)
+    File.open(list_file, "w") { |list|
+      files.each { |file| list.puts file }
+    }
+    FileUtils.rm_f(out_file)
+
+    log_text = ""
+    IO.popen("root -b -q \'MergeFiles.C(#{files.size}, \"#{list_file}\", \"#{out_file}\")\' 2>&1") { |root|
+      root.each_line do |line|
+        puts line
+        log_text << line
+      end
+    }
+    return $?.success? && merge_ok?(out_file, log_text)
+  end
+
+  # merge 'inputs' into 'out_file', only reading inputs (and the
+  # previous result) that aren't already accounted for
+  def self.incremental_merge(inputs, list_file, out_file)
+
+    todo = plan(out_file, inputs)
+
+    # refuse to double count
+    unless todo[:duplicates].empty?
+      todo[:duplicates].each do |path, other|
+        STDERR.puts "PANIC: #{path} duplicates #{other}!"
+      end
+      abort("PANIC: refusing to merge duplicate inputs into #{out_file}.")
+    end
+
+    # a changed input can't be taken back out of the merged
+    # file, so everything has to be merged again (including
+    # inputs merged before that weren't passed this time)
+    manifest = {}
+    if !todo[:changed].empty?
+      todo[:changed].each { |entry| puts "  Input changed since last merge: #{entry.path}" }
+      puts "  Rebuilding #{out_file} from scratch."
+
+      passed   = inputs.map { |path| File.expand_path(path) }
+      previous = load(out_file).values.reject { |entry| passed.include?(entry.path) }
+      missing  = previous.reject { |entry| File.exist?(entry.path) }
+      unless missing.empty?
+        missing.each { |entry| STDERR.puts "PANIC: #{entry.path} was merged before but is gone!" }
+        STDERR.puts "PANIC: can't rebuild #{out_file} without it."
+        return false
+      end
+      previous.map! do |entry|
+        stat = File.stat(entry.path)
+        (entry.size == stat.size && entry.mtime == stat.mtime.to_i) ? entry : describe(entry.path)
+      end
+
+      entries = todo[:merged] + todo[:changed] + todo[:new] + previous
+      to_read = entries.map(&:path)
+    else
+      if todo[:new].empty?
+        puts "  Nothing new to merge into #{out_file}."
+        return true
+      end
+
+      # inputs merged before stay in the result, even if they
+      # weren't passed this time
+      manifest = load(out_file)
+      entries  = todo[:merged] + todo[:new]
+      to_read  = todo[:new].map(&:path)
+      to_read.unshift(out_file) unless manifest.empty?
+    end
+    puts "  Merging #{to_read.size} files (#{todo[:new].size} new, #{todo[:merged].size} already merged) into #{out_file}."
+
+    # merge into a temporary, then swap it in
+    tmp_file = out_file.sub(/\.root$/, "") + ".incremental.root"
+    unless run_merge(to_read, list_file, tmp_file)
+      STDERR.puts "WARNING: merge into #{out_file} failed, leaving it (and its manifest) as they were!"
+      return false
+    end
+    FileUtils.mv(tmp_file, out_file)
+
+    entries.each { |entry| manifest[entry.path] = entry }
+    save(out_file, manifest)
+    return true
+  end
+
+end
+
+# end -------------------------------------------------------------------------
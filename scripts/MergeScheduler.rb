@@ -0,0 +1,153 @@
+#!/usr/bin/env ruby
+# -----------------------------------------------------------------------------
+# 'MergeScheduler.rb'
+# Derek Anderson
+# 10.18.2026
+#
+# Runs a graph of merges with 'MergeFiles.C' locally.
+# Merges whose inputs are ready run side-by-side as
+# long as they fit in the cpu and memory budget, and
+# merges whose output is already up to date (according
+# to its manifest, see 'MergeManifest.rb') are skipped,
+# so a crashed run can simply be restarted.
+# -----------------------------------------------------------------------------
+
+# modules to use
+require 'fileutils'
+require_relative 'MergeManifest'
+
+module MergeScheduler
+
+  # one merge: 'inputs' are files, 'deps' are names of
+  # other jobs whose outputs have to exist first
+  Job = Struct.new(:name, :inputs, :output, :deps, :cpus, :mem_gb) do
+    def list_file
+      return output.sub(/\.root$/, "") + ".list"
+    end
+  end
+
+  # output exists and its manifest lists exactly the current inputs
+  # with the same size and mtime (nothing is checksummed here: a
+  # touched input just gets merged again)
+  def self.up_to_date?(job)
+    return false unless File.exist?(job.output)
+    known = MergeManifest.load(job.output)
+    paths = job.inputs.map { |input| File.expand_path(input) }.uniq
+    return false unless paths.size == job.inputs.size && known.size == paths.size
+
+    return paths.all? do |path|
+      entry = known[path]
+      next false unless entry && File.exist?(path)
+      stat = File.stat(path)
+      entry.size == stat.size && entry.mtime == stat.mtime.to_i
+    end
+  end
+
+  # launch a merge in the background
+  def self.launch(job)
+
+    # a half-written (or stale) output must never look up to date
+    FileUtils.rm_f(MergeManifest.manifest_path(job.output))
+    FileUtils.rm_f(job.output)
+    File.open(job.list_file, "w") { |list|
+      job.inputs.each { |file| list.puts file }
+    }
+    cmd = "root -b -q \'MergeFiles.C(#{job.inputs.size}, \"#{job.list_file}\", \"#{job.output}\", #{job.cpus})\'"
+    return Process.spawn(cmd, [:out, :err] => [log_file(job), "w"])
+  end
+
+  # log of a merge sits next to its output
+  def self.log_file(job)
+    return job.output.sub(/\.root$/, "") + ".log"
+  end
+
+  # run jobs, returns true if everything merged
+  def self.run(jobs, max_cpus, max_mem_gb)
+
+    by_name = {}
+    jobs.each { |job| by_name[job.name] = job }
+
+    waiting = jobs.dup
+    running = {}
+    done    = {}
+    failed  = {}
+    current = {}
+    used    = { :cpus => 0, :mem_gb => 0 }
+    t_start = Time.now
+
+    until waiting.empty? && running.empty?
+
+      # start everything that's ready and fits
+      progressed = false
+      waiting.dup.each do |job|
+
+        # nothing downstream of a failure can run
+        if job.deps.any? { |dep| failed[dep] }
+          puts "  Skipping #{job.name}: an input failed to merge."
+          failed[job.name] = true
+          waiting.delete(job)
+          progressed = true
+          next
+        end
+        next unless job.deps.all? { |dep| done[dep] }
+
+        # only checked once: deps are done, so the inputs won't change
+        current[job.name] = up_to_date?(job) unless current.key?(job.name)
+        if current[job.name]
+          puts "  #{job.name} is up to date, skipping."
+          done[job.name] = true
+          waiting.delete(job)
+          progressed = true
+          next
+        end
+
+        # a job bigger than the budget still runs, but alone
+        fits = (used[:cpus] + job.cpus <= max_cpus) && (used[:mem_gb] + job.mem_gb <= max_mem_gb)
+        next unless fits || running.empty?
+
+        pid = launch(job)
+        running[pid]    = [job, Time.now]
+        used[:cpus]    += job.cpus
+        used[:mem_gb]  += job.mem_gb
+        waiting.delete(job)
+        puts "  Started #{job.name} (#{job.inputs.size} inputs, #{used[:cpus]}/#{max_cpus} cpus, #{used[:mem_gb]}/#{max_mem_gb} GB in use)."
+      end
+
+      # a job waiting on a dependency that will never finish
+      if running.empty?
+        waiting.each do |job|
+          missing = job.deps.reject { |dep| by_name[dep] }
+          STDERR.puts "PANIC: #{job.name} depends on unknown jobs #{missing.join(", ")}!" unless missing.empty?
+        end
+        break unless progressed
+        next
+      end
+
+      # wait for any merge to finish
+      pid, status = Process.wait2
+      job, t_job = running.delete(pid)
+      used[:cpus]   -= job.cpus
+      used[:mem_gb] -= job.mem_gb
+      merged = status.success? && MergeManifest.merge_ok?(job.output, File.read(log_file(job)))
+      if merged
+        entries = {}
+        job.inputs.each do |input|
+          entry = MergeManifest.describe(File.expand_path(input))
+          entries[entry.path] = entry
+        end
+        MergeManifest.save(job.output, entries)
+        done[job.name] = true
+        puts "  Finished #{job.name} in #{(Time.now - t_job).round(1)} s."
+      else
+        failed[job.name] = true
+        STDERR.puts "WARNING: #{job.name} failed (exit #{status.exitstatus}, see #{log_file(job)})!"
+      end
+    end
+
+    puts "  Merged #{done.size}/#{jobs.size} jobs in #{(Time.now - t_start).round(1)} s."
+    return failed.empty? && done.size == jobs.size
+  end
+
+end
+
+# end -------------------------------------------------------------------------
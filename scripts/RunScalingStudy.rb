@@ -0,0 +1,107 @@
+#!/usr/bin/env ruby
+# -----------------------------------------------------------------------------
+# 'RunScalingStudy.rb'
+# Derek Anderson
+# 10.18.2026
+#
+# Sweeps 'DoTrackCutStudyBenchmark.C' over input
+# size, save threads, enabled types, histogram
+# families, and no. of concurrent instances on
+# synthetic input (see 'macros/MakeSyntheticTuples.C').
+# Each dimension is swept on its own around a
+# baseline, and every run is appended to one csv
+# file.  'macros/PlotScalingStudy.C' then makes the
+# summary table and plots.
+#
+# Should be run from the top-level directory.
+#
+# Usage: ruby scripts/RunScalingStudy.rb [results csv]
+# -----------------------------------------------------------------------------
+
+# modules to use
+require 'fileutils'
+
+module ScalingStudy
+
+  # sweep values (first of each is the baseline)
+  Events    = [10000, 1000, 100000]
+  Threads   = [1, 2, 4, 8]
+  TypeSets  = [[true, true], [false, false], [true, false], [false, true]]  # [before cuts, pileup]
+  Families  = ["all", "Spec", "Spec,Diff,Frac", "Spec,Diff,Frac,VsNTpc,VsPtTrue"]
+  Instances = [1, 2, 4, 8]
+
+  # synthetic input parameters
+  NEmbed   = 20.0
+  NPileup  = 200.0
+  WorkDir  = "scalingStudy"
+
+  # one run of the benchmark
+  Run = Struct.new(:label, :events, :threads, :before_cuts, :pileup, :families, :instances)
+
+  def self.input_files(events)
+    return ["#{WorkDir}/synthetic.embedOnly.n#{events}.root", "#{WorkDir}/synthetic.withPileup.n#{events}.root"]
+  end
+
+  # make synthetic inputs (if needed)
+  def self.make_inputs(events)
+    file_eo, file_pu = input_files(events)
+    unless File.exist?(file_eo)
+      system("root -b -q \'macros/MakeSyntheticTuples.C(\"#{file_eo}\", #{events}, #{NEmbed}, 0.)\'") or abort "PANIC: couldn't make #{file_eo}!"
+    end
+    unless File.exist?(file_pu)
+      system("root -b -q \'macros/MakeSyntheticTuples.C(\"#{file_pu}\", #{events}, 5., #{NPileup}, 0.05, 0.01, false, 2)\'") or abort "PANIC: couldn't make #{file_pu}!"
+    end
+  end
+
+  # build sweeps: vary one dimension at a time around the baseline
+  def self.plan
+    base = Run.new("baseline", Events[0], Threads[0], TypeSets[0][0], TypeSets[0][1], Families[0], Instances[0])
+    runs = [base]
+    Events[1..-1].each    { |val| runs << base.dup.tap { |run| run.label = "events";    run.events    = val } }
+    Threads[1..-1].each   { |val| runs << base.dup.tap { |run| run.label = "threads";   run.threads   = val } }
+    TypeSets[1..-1].each  { |val| runs << base.dup.tap { |run| run.label = "types";     run.before_cuts, run.pileup = val } }
+    Families[1..-1].each  { |val| runs << base.dup.tap { |run| run.label = "families";  run.families  = val } }
+    Instances[1..-1].each { |val| runs << base.dup.tap { |run| run.label = "instances"; run.instances = val } }
+    return runs
+  end
+
+  # output/log prefix of a run (the run index keeps sweep points apart)
+  def self.run_prefix(run, iRun)
+    return "#{WorkDir}/benchmark.#{run.label}.run#{iRun}"
+  end
+
+  # run (possibly several concurrent instances of) the benchmark
+  def self.launch(run, iRun, results)
+    file_eo, file_pu = input_files(run.events)
+    pids = (0...run.instances).map do |instance|
+      out  = "#{run_prefix(run, iRun)}.#{instance}.root"
+      log  = "#{run_prefix(run, iRun)}.#{instance}.log"
+      args = "\"#{file_eo}\", \"#{file_pu}\", #{run.pileup}, #{run.threads}, \"#{results}\", \"#{run.label}\", #{run.before_cuts}, \"#{run.families}\", \"#{out}\", #{run.instances}"
+      Process.spawn("root -b -q \'DoTrackCutStudyBenchmark.C(#{args})\'", [:out, :err] => [log, "w"])
+    end
+    statuses = pids.map { |pid| Process.wait2(pid)[1] }
+    return statuses.all?(&:success?)
+  end
+
+end
+
+# run sweeps --------------------------------------------------------------------
+
+results = ARGV[0] || "scalingStudy.csv"
+FileUtils.mkdir_p(ScalingStudy::WorkDir)
+FileUtils.rm_f(results)
+
+runs = ScalingStudy.plan
+puts "  Running scaling study: #{runs.size} configurations..."
+runs.map(&:events).uniq.each { |events| ScalingStudy.make_inputs(events) }
+
+t_start = Time.now
+runs.each_with_index do |run, iRun|
+  puts "    [#{iRun + 1}/#{runs.size}] #{run.label}: events = #{run.events}, threads = #{run.threads}, " \
+       "before cuts = #{run.before_cuts}, pileup = #{run.pileup}, families = #{run.families}, instances = #{run.instances}"
+  puts "WARNING: run '#{run.label}' failed, see '#{ScalingStudy.run_prefix(run, iRun)}.*.log'!" unless ScalingStudy.launch(run, iRun, results)
+end
+puts "  Finished scaling study in #{(Time.now - t_start).round(1)} s! Results in '#{results}'."
+puts "  Make the summary with: root -b -q \'macros/PlotScalingStudy.C(\"#{results}\")\'"
+
+# end -------------------------------------------------------------------------
@@ -19,6 +19,7 @@ copy_to   = "/sphenix/user/danderson/sphenix/analysis/AndersonAnalysisModules/Tr
 to_copy = [
   "README.md",
   "DoTrackCutStudy.C",
+  "DoTrackCutStudyPlots.C",
   "DoFastTrackCutStudy.C",
   "DoFastTrackCutStudy.sh",
   "DoTrackCutStudyOnCondor.sh",
@@ -31,9 +32,17 @@ to_copy = [
   "macros/Fun4All_G4_sPHENIX_ForTrackCutStudy_WithPileup_EmbedScanOff.C",
   "macros/G4Setup_sPHENIX.C",
   "macros/MergeFiles.C",
+  "macros/DatasetCatalog.h",
+  "macros/BuildDatasetCatalog.C",
+  "macros/HistogramReaders.h",
+  "macros/MakeBatchRatioPlots.C",
+  "macros/MakeClusterSummary.C",
+  "macros/ratioComparisons.spec",
   "scripts/MergeFiles.rb",
   "scripts/MergeCondorFiles.rb",
   "scripts/MergeFilesFromList.rb",
+  "scripts/MergeManifest.rb",
+  "scripts/MergeScheduler.rb",
   "scripts/RunCreateFileList.sh",
   "scripts/RunSingleTrackCutStudyG4.sh",
   "scripts/RunSingleTrackCutStudyWithPileupG4.sh",
@@ -44,9 +44,559 @@ Bool_t STrackCutStudy::ApplyCuts(const Bool_t isPrimary, const UInt_t trkNMVtx,
 
 Bool_t STrackCutStudy::DoClusterCalculation() {
 
-  /* cluster calc will go here */
+  // check for tuple
+  if (!ntClustEO) {
+    cerr << "PANIC: no input cluster tuple!\n"
+         << "       ntClustEO = " << ntClustEO
+         << endl;
+    assert(ntClustEO);
+  }
+
+  // only read the leaves needed for the index
+  Float_t clustEvent(0.);
+  Float_t clustSeed(0.);
+  Float_t clustTrack(0.);
+  Float_t clustSize(0.);
+  ntClustEO -> SetBranchStatus("*",       0);
+  ntClustEO -> SetBranchStatus("event",   1);
+  ntClustEO -> SetBranchStatus("seed",    1);
+  ntClustEO -> SetBranchStatus("trackID", 1);
+  ntClustEO -> SetBranchStatus("size",    1);
+  ntClustEO -> SetBranchAddress("event",   &clustEvent);
+  ntClustEO -> SetBranchAddress("seed",    &clustSeed);
+  ntClustEO -> SetBranchAddress("trackID", &clustTrack);
+  ntClustEO -> SetBranchAddress("size",    &clustSize);
+
+  // build index in one pass over clusters
+  const Long64_t nClusts = ntClustEO -> GetEntries();
+  cout << "      Indexing clusters by track: " << nClusts << " clusters to process..." << endl;
+
+  clustIndex.clear();
+  Long64_t nOnTrack(0);
+  for (Long64_t iClust = 0; iClust < nClusts; iClust++) {
+    const Long64_t bytes = ntClustEO -> GetEntry(iClust);
+    if (bytes < 0.) {
+      cerr << "WARNING: something wrong with cluster entry #" << iClust << "! Aborting loop!" << endl;
+      break;
+    }
+
+    // skip clusters not on a track
+    if (isnan(clustTrack) || (clustTrack < 0.)) continue;
+
+    const TrackKey key = {(Long64_t) clustEvent, (Long64_t) clustSeed, (Long64_t) clustTrack};
+    ClusterSum &sum = clustIndex[key];
+    sum.nClust  += 1;
+    sum.sumSize += clustSize;
+    nOnTrack++;
+  }
+  cout << "      Indexed " << nOnTrack << " clusters onto " << clustIndex.size() << " tracks." << endl;
   return true;
 
-}  // end 'DoClusterCalculation'
+}  // end 'DoClusterCalculation()'
+
+
+
+void STrackCutStudy::GetTrackClusters(const Float_t trkEvent, const Float_t trkSeed, const Float_t trkID, Double_t &nClust, Double_t &avgSize) {
+
+  nClust  = 0.;
+  avgSize = 0.;
+
+  const TrackKey key = {(Long64_t) trkEvent, (Long64_t) trkSeed, (Long64_t) trkID};
+  auto found = clustIndex.find(key);
+  if (found == clustIndex.end()) return;
+
+  nClust  = (Double_t) found -> second.nClust;
+  avgSize = found -> second.sumSize / nClust;
+  return;
+
+}  // end 'GetTrackClusters(Float_t, Float_t, Float_t, Double_t&, Double_t&)'
+
+
+
+void STrackCutStudy::BuildEventIndex(TNtuple *tuple, Float_t &evtLeaf, Float_t &seedLeaf, vector<Long64_t> &entries, vector<Long64_t> &starts) {
+
+  // only the event and seed branches are read
+  TBranch *bEvent = tuple -> GetBranch("event");
+  TBranch *bSeed  = tuple -> GetBranch("seed");
+  if (!bEvent || !bSeed) {
+    cerr << "PANIC: tuple '" << tuple -> GetName() << "' is missing an event or seed branch!\n"
+         << "       bEvent = " << bEvent << ", bSeed = " << bSeed
+         << endl;
+    assert(bEvent && bSeed);
+  }
+
+  // group entries by (event, seed) in order of first appearance
+  map<pair<Long64_t, Long64_t>, size_t> slots;
+  vector<vector<Long64_t>>               groups;
+
+  const Long64_t nEntries = tuple -> GetEntries();
+  for (Long64_t iEntry = 0; iEntry < nEntries; iEntry++) {
+    bEvent -> GetEntry(iEntry);
+    bSeed  -> GetEntry(iEntry);
+
+    const pair<Long64_t, Long64_t> key  = {(Long64_t) evtLeaf, (Long64_t) seedLeaf};
+    auto                           slot = slots.find(key);
+    if (slot == slots.end()) {
+      slot = slots.emplace(key, groups.size()).first;
+      groups.emplace_back();
+    }
+    groups[slot -> second].push_back(iEntry);
+  }
+
+  // flatten so each event is a contiguous batch
+  entries.clear();
+  starts.clear();
+  entries.reserve(nEntries);
+  starts.reserve(groups.size() + 1);
+  for (const vector<Long64_t> &group : groups) {
+    starts.push_back(entries.size());
+    entries.insert(entries.end(), group.begin(), group.end());
+  }
+  starts.push_back(entries.size());
+  cout << "      Indexed " << nEntries << " entries of '" << tuple -> GetName() << "' into " << groups.size() << " events." << endl;
+  return;
+
+}  // end 'BuildEventIndex(TNtuple*, Float_t&, Float_t&, vector<Long64_t>&, vector<Long64_t>&)'
+
+
+
+Long64_t STrackCutStudy::ProcessPileupEntry(const Long64_t iEntry, const Long64_t iProg, const Long64_t nEntries) {
+
+  // arrays for filling histograms
+  Double_t recoTrkVars[NTrkVar];
+  Double_t trueTrkVars[NTrkVar];
+  Double_t recoPhysVars[NPhysVar];
+  Double_t truePhysVars[NPhysVar];
+
+  // grab entry
+  const Long64_t bytesPU = ntTrkPU -> GetEntry(iEntry);
+  if (bytesPU < 0.) {
+    cerr << "WARNING: something wrong with with-pileup entry #" << iEntry << "! Aborting loop!" << endl;
+    return bytesPU;
+  }
+
+  // announce progress
+  if (inBatchMode) {
+    cout << "        Processing with-pileup entry " << iProg << "/" << nEntries << "..." << endl;
+  } else {
+    if (iProg == nEntries) {
+      cout << "        Processing with-pileup entry " << iProg << "/" << nEntries << "..." << endl;
+    } else {
+      cout << "        Processing with-pileup entry " << iProg << "/" << nEntries << "...\r" << flush;
+    }
+  }
+
+  // perform calculations
+  const Double_t umDcaXY    = pu_dca3dxy * 10000;
+  const Double_t umDcaZ     = pu_dca3dz * 10000;
+  const Double_t deltaDcaXY = abs(pu_dca3dxy / pu_dca3dxysigma);
+  const Double_t deltaDcaZ  = abs(pu_dca3dz / pu_dca3dzsigma);
+  const Double_t deltaEta   = abs(pu_deltaeta / pu_eta);
+  const Double_t deltaPhi   = abs(pu_deltaphi / pu_phi);
+  const Double_t deltaPt    = abs(pu_deltapt / pu_pt);
+
+  // check if values are defined
+  const Bool_t thereAreNans = (isnan(pu_dca3dxy) || isnan(pu_dca3dz) || isnan(pu_eta) || isnan(pu_phi) || isnan(pu_pt));
+  if (thereAreNans) return bytesPU;
+
+  // set reco track variables
+  recoTrkVars[TRKVAR::VX]       = pu_vx;
+  recoTrkVars[TRKVAR::VY]       = pu_vy;
+  recoTrkVars[TRKVAR::VZ]       = pu_vz;
+  recoTrkVars[TRKVAR::NMMS]     = (Double_t) pu_nlmms;
+  recoTrkVars[TRKVAR::NMAP]     = (Double_t) pu_nlmaps;
+  recoTrkVars[TRKVAR::NINT]     = (Double_t) pu_nlintt;
+  recoTrkVars[TRKVAR::NTPC]     = (Double_t) pu_ntpc;
+  recoTrkVars[TRKVAR::QUAL]     = pu_quality;
+  recoTrkVars[TRKVAR::DCAXY]    = umDcaXY;
+  recoTrkVars[TRKVAR::DCAZ]     = umDcaZ;
+  recoTrkVars[TRKVAR::DELDCAXY] = deltaDcaXY;
+  recoTrkVars[TRKVAR::DELDCAZ]  = deltaDcaZ;
+  recoTrkVars[TRKVAR::NCLUST]   = 0.;
+  recoTrkVars[TRKVAR::AVGCLUST] = 0.;
+
+  // set true track variables
+  trueTrkVars[TRKVAR::VX]       = pu_gvx;
+  trueTrkVars[TRKVAR::VY]       = pu_gvy;
+  trueTrkVars[TRKVAR::VZ]       = pu_gvz;
+  trueTrkVars[TRKVAR::NMMS]     = (Double_t) pu_gnlmms;
+  trueTrkVars[TRKVAR::NMAP]     = (Double_t) pu_gnlmaps;
+  trueTrkVars[TRKVAR::NINT]     = (Double_t) pu_gnlintt;
+  trueTrkVars[TRKVAR::NTPC]     = (Double_t) pu_gntpc;
+  trueTrkVars[TRKVAR::QUAL]     = pu_quality;
+  trueTrkVars[TRKVAR::DCAXY]    = umDcaXY;
+  trueTrkVars[TRKVAR::DCAZ]     = umDcaZ;
+  trueTrkVars[TRKVAR::DELDCAXY] = deltaDcaXY;
+  trueTrkVars[TRKVAR::DELDCAZ]  = deltaDcaZ;
+  trueTrkVars[TRKVAR::NCLUST]   = 0.;
+  trueTrkVars[TRKVAR::AVGCLUST] = 0.;
+
+  // set reco phys variables
+  recoPhysVars[PHYSVAR::PHI]    = pu_phi;
+  recoPhysVars[PHYSVAR::ETA]    = pu_eta;
+  recoPhysVars[PHYSVAR::PT]     = pu_pt;
+  recoPhysVars[PHYSVAR::DELPHI] = deltaPhi;
+  recoPhysVars[PHYSVAR::DELETA] = deltaEta;
+  recoPhysVars[PHYSVAR::DELPT]  = deltaPt;
+
+  // set true phys variables
+  truePhysVars[PHYSVAR::PHI]    = pu_gphi;
+  truePhysVars[PHYSVAR::ETA]    = pu_geta;
+  truePhysVars[PHYSVAR::PT]     = pu_gpt;
+  truePhysVars[PHYSVAR::DELPHI] = deltaPhi;
+  truePhysVars[PHYSVAR::DELETA] = deltaEta;
+  truePhysVars[PHYSVAR::DELPT]  = deltaPt;
+
+  // compare to same particle without pileup (only embedded particles are in both samples)
+  if (doPairing && (pu_gembed > 0)) FillPairedHists(PAIRMODE::PAIR_PU, pu_event, pu_seed, pu_gtrackID, recoTrkVars, recoPhysVars, truePhysVars[PHYSVAR::PT]);
+
+  // check for primary tracks
+  const Bool_t isPrimary = (pu_gprimary == 1);
+
+  // fill all histograms
+  if (doBeforeCuts) {
+    FillTrackHistograms(TYPE::PILEUP, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+    if (isPrimary) {
+      FillTrackHistograms(TYPE::PRIMARY, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+    } else {
+      FillTrackHistograms(TYPE::NONPRIM, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+    }
+  }
+
+  // apply cuts
+  const Bool_t isGoodTrk = ApplyCuts(isPrimary, (UInt_t) pu_nlmaps, (UInt_t) pu_ntpc, pu_vz, umDcaXY, umDcaZ, pu_quality);
+  if (!isGoodTrk) return bytesPU;
+
+  // fill cut histograms
+  FillTrackHistograms(TYPE::PILE_CUT, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+  if (isPrimary) {
+    FillTrackHistograms(TYPE::PRIM_CUT, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+  } else {
+    FillTrackHistograms(TYPE::NONPRIM_CUT, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+  }
+  return bytesPU;
+
+}  // end 'ProcessPileupEntry(Long64_t, Long64_t, Long64_t)'
+
+
+
+void STrackCutStudy::FindDuplicates(TNtuple *tuple, Float_t &evtLeaf, Float_t &seedLeaf, Float_t &gtrkLeaf, vector<UInt_t> &dupMult) {
+
+  // only the event, seed, and truth-match branches are read
+  TBranch *bEvent = tuple -> GetBranch("event");
+  TBranch *bSeed  = tuple -> GetBranch("seed");
+  TBranch *bGTrk  = tuple -> GetBranch("gtrackID");
+  if (!bEvent || !bSeed || !bGTrk) {
+    cerr << "PANIC: tuple '" << tuple -> GetName() << "' is missing an event, seed, or gtrackID branch!\n"
+         << "       bEvent = " << bEvent << ", bSeed = " << bSeed << ", bGTrk = " << bGTrk
+         << endl;
+    assert(bEvent && bSeed && bGTrk);
+  }
+
+  // count tracks per truth match, remembering each entry's match
+  const Long64_t nEntries = tuple -> GetEntries();
+
+  unordered_map<TrackKey, UInt_t, TrackKeyHash> nMatched;
+  vector<TrackKey>                              entryKeys(nEntries);
+  vector<Bool_t>                                isMatched(nEntries, false);
+  for (Long64_t iEntry = 0; iEntry < nEntries; iEntry++) {
+    bEvent -> GetEntry(iEntry);
+    bSeed  -> GetEntry(iEntry);
+    bGTrk  -> GetEntry(iEntry);
+
+    // unmatched tracks can't be duplicates
+    if (isnan(gtrkLeaf) || (gtrkLeaf < 0.)) continue;
+
+    entryKeys[iEntry] = {(Long64_t) evtLeaf, (Long64_t) seedLeaf, (Long64_t) gtrkLeaf};
+    isMatched[iEntry] = true;
+    nMatched[entryKeys[iEntry]]++;
+  }
+
+  // no. of tracks sharing each entry's truth match (0 if unmatched)
+  Long64_t nDuplicates(0);
+  dupMult.assign(nEntries, 0);
+  for (Long64_t iEntry = 0; iEntry < nEntries; iEntry++) {
+    if (!isMatched[iEntry]) continue;
+    dupMult[iEntry] = nMatched[entryKeys[iEntry]];
+    if (dupMult[iEntry] > 1) nDuplicates++;
+  }
+  cout << "      Found " << nDuplicates << " duplicate tracks among " << nMatched.size() << " truth-matched particles in '" << tuple -> GetName() << "'." << endl;
+  return;
+
+}  // end 'FindDuplicates(TNtuple*, Float_t&, Float_t&, Float_t&, vector<UInt_t>&)'
+
+
+
+void STrackCutStudy::BuildTruthIndex() {
+
+  // only read the truth leaves needed
+  Float_t truEvent(0.);
+  Float_t truSeed(0.);
+  Float_t truID(0.);
+  Float_t truPrimary(0.);
+  Float_t truEffVars[NEffVar];
+
+  const TString sTruEffLeaves[NEffVar] = {"gpt", "geta", "gphi", "gntpc"};
+  ntTruEO -> SetBranchStatus("*",        0);
+  ntTruEO -> SetBranchStatus("event",    1);
+  ntTruEO -> SetBranchStatus("seed",     1);
+  ntTruEO -> SetBranchStatus("gtrackID", 1);
+  ntTruEO -> SetBranchStatus("gprimary", 1);
+  ntTruEO -> SetBranchAddress("event",    &truEvent);
+  ntTruEO -> SetBranchAddress("seed",     &truSeed);
+  ntTruEO -> SetBranchAddress("gtrackID", &truID);
+  ntTruEO -> SetBranchAddress("gprimary", &truPrimary);
+  for (Ssiz_t iEffVar = 0; iEffVar < NEffVar; iEffVar++) {
+    ntTruEO -> SetBranchStatus(sTruEffLeaves[iEffVar].Data(), 1);
+    ntTruEO -> SetBranchAddress(sTruEffLeaves[iEffVar].Data(), &truEffVars[iEffVar]);
+  }
+
+  // build join table in one pass over truth particles
+  const Long64_t nTruths = ntTruEO -> GetEntries();
+  cout << "      Indexing truth particles: " << nTruths << " particles to process..." << endl;
+
+  truthIndex.clear();
+  truthIndex.reserve(nTruths);
+  for (Long64_t iTruth = 0; iTruth < nTruths; iTruth++) {
+    const Long64_t bytes = ntTruEO -> GetEntry(iTruth);
+    if (bytes < 0.) {
+      cerr << "WARNING: something wrong with truth entry #" << iTruth << "! Aborting loop!" << endl;
+      break;
+    }
+
+    const TrackKey key   = {(Long64_t) truEvent, (Long64_t) truSeed, (Long64_t) truID};
+    TruthMatch    &match = truthIndex[key];
+    for (Ssiz_t iEffVar = 0; iEffVar < NEffVar; iEffVar++) {
+      match.effVars[iEffVar] = truEffVars[iEffVar];
+    }
+    for (Ssiz_t iLevel = 0; iLevel < NCutLevel; iLevel++) {
+      match.isFound[iLevel] = false;
+    }
+    match.isPrimary = (truPrimary == 1);
+  }
+  cout << "      Indexed " << truthIndex.size() << " truth particles." << endl;
+  return;
+
+}  // end 'BuildTruthIndex()'
+
+
+
+void STrackCutStudy::MatchTrackToTruth(const Double_t recoEffVars[], const Double_t purity, const Bool_t isGoodTrk) {
+
+  // a track is fake if it has no truth partner or is a ghost
+  auto found = truthIndex.end();
+  if (!isnan(gtrackID)) {
+    const TrackKey key = {(Long64_t) event, (Long64_t) seed, (Long64_t) gtrackID};
+    found = truthIndex.find(key);
+  }
+  const Bool_t isFake = ((found == truthIndex.end()) || (purity < ghostPurityMin));
+
+  // level 0 is before cuts, level 1 after
+  const Bool_t isAtLevel[NCutLevel] = {true, isGoodTrk};
+  for (Ssiz_t iLevel = 0; iLevel < NCutLevel; iLevel++) {
+    if (!isAtLevel[iLevel]) continue;
+    for (Ssiz_t iEffVar = 0; iEffVar < NEffVar; iEffVar++) {
+      eTrkFake[iLevel][iEffVar] -> Fill(isFake, recoEffVars[iEffVar]);
+    }
+    if (!isFake) found -> second.isFound[iLevel] = true;
+  }
+  return;
+
+}  // end 'MatchTrackToTruth(Double_t[], Double_t, Bool_t)'
+
+
+
+void STrackCutStudy::FillEfficiencies() {
+
+  // denominator is all primary truth particles
+  for (const auto &entry : truthIndex) {
+    const TruthMatch &match = entry.second;
+    if (!match.isPrimary) continue;
+
+    for (Ssiz_t iLevel = 0; iLevel < NCutLevel; iLevel++) {
+      for (Ssiz_t iEffVar = 0; iEffVar < NEffVar; iEffVar++) {
+        eTrkEff[iLevel][iEffVar] -> Fill(match.isFound[iLevel], match.effVars[iEffVar]);
+      }
+    }
+  }
+  truthIndex.clear();
+  cout << "      Filled efficiencies." << endl;
+  return;
+
+}  // end 'FillEfficiencies()'
+
+
+
+void STrackCutStudy::AddPairedTrack(const Float_t trkEvent, const Float_t trkSeed, const Float_t trkGID, const Double_t recoTrkVars[], const Double_t recoPhysVars[]) {
+
+  // only truth-matched tracks can be paired
+  if (isnan(trkGID) || (trkGID < 0.)) return;
+
+  // keep first track of each particle
+  const TrackKey key = {(Long64_t) trkEvent, (Long64_t) trkSeed, (Long64_t) trkGID};
+  auto added = pairIndex.emplace(key, PairedTrack());
+  if (!added.second) return;
+
+  PairedTrack &paired = added.first -> second;
+  for (Ssiz_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+    paired.trkVars[iTrkVar] = recoTrkVars[iTrkVar];
+  }
+  for (Ssiz_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+    paired.physVars[iPhysVar] = recoPhysVars[iPhysVar];
+  }
+  return;
+
+}  // end 'AddPairedTrack(Float_t, Float_t, Float_t, Double_t[], Double_t[])'
+
+
+
+void STrackCutStudy::FillPairedHists(const Int_t mode, const Float_t trkEvent, const Float_t trkSeed, const Float_t trkGID, const Double_t recoTrkVars[], const Double_t recoPhysVars[], const Double_t ptTrue) {
+
+  if (isnan(trkGID) || (trkGID < 0.)) return;
+
+  const TrackKey key = {(Long64_t) trkEvent, (Long64_t) trkSeed, (Long64_t) trkGID};
+  auto found = pairIndex.find(key);
+  if (found == pairIndex.end()) return;
+
+  // differences are (with pileup - embed only) or (candidate - baseline)
+  const PairedTrack &paired = found -> second;
+  for (Ssiz_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+    const Double_t diff = recoTrkVars[iTrkVar] - paired.trkVars[iTrkVar];
+    hPairTrkDiff[mode][iTrkVar]         -> Fill(diff);
+    hPairTrkDiffVsPtTrue[mode][iTrkVar] -> Fill(ptTrue, diff);
+  }
+  for (Ssiz_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+    const Double_t diff = recoPhysVars[iPhysVar] - paired.physVars[iPhysVar];
+    hPairPhysDiff[mode][iPhysVar]         -> Fill(diff);
+    hPairPhysDiffVsPtTrue[mode][iPhysVar] -> Fill(ptTrue, diff);
+  }
+  nPaired[mode]++;
+  return;
+
+}  // end 'FillPairedHists(Int_t, Float_t, Float_t, Float_t, Double_t[], Double_t[], Double_t)'
+
+
+
+void STrackCutStudy::CalculateEmbedVars(const Double_t nClust, const Double_t avgClust, Double_t recoTrkVars[], Double_t trueTrkVars[], Double_t recoPhysVars[], Double_t truePhysVars[]) {
+
+  // perform calculations
+  const Double_t umDcaXY    = dca3dxy * 10000;
+  const Double_t umDcaZ     = dca3dz * 10000;
+  const Double_t deltaDcaXY = abs(dca3dxy / dca3dxysigma);
+  const Double_t deltaDcaZ  = abs(dca3dz / dca3dzsigma);
+  const Double_t deltaEta   = abs(deltaeta / eta);
+  const Double_t deltaPhi   = abs(deltaphi / phi);
+  const Double_t deltaPt    = abs(deltapt / pt);
+
+  // set reco track variables
+  recoTrkVars[TRKVAR::VX]       = vx;
+  recoTrkVars[TRKVAR::VY]       = vy;
+  recoTrkVars[TRKVAR::VZ]       = vz;
+  recoTrkVars[TRKVAR::NMMS]     = (Double_t) nlmms;
+  recoTrkVars[TRKVAR::NMAP]     = (Double_t) nlmaps;
+  recoTrkVars[TRKVAR::NINT]     = (Double_t) nlintt;
+  recoTrkVars[TRKVAR::NTPC]     = (Double_t) ntpc;
+  recoTrkVars[TRKVAR::QUAL]     = quality;
+  recoTrkVars[TRKVAR::DCAXY]    = umDcaXY;
+  recoTrkVars[TRKVAR::DCAZ]     = umDcaZ;
+  recoTrkVars[TRKVAR::DELDCAXY] = deltaDcaXY;
+  recoTrkVars[TRKVAR::DELDCAZ]  = deltaDcaZ;
+  recoTrkVars[TRKVAR::NCLUST]   = nClust;
+  recoTrkVars[TRKVAR::AVGCLUST] = avgClust;
+
+  // set true track variables
+  trueTrkVars[TRKVAR::VX]       = gvx;
+  trueTrkVars[TRKVAR::VY]       = gvy;
+  trueTrkVars[TRKVAR::VZ]       = gvz;
+  trueTrkVars[TRKVAR::NMMS]     = (Double_t) gnlmms;
+  trueTrkVars[TRKVAR::NMAP]     = (Double_t) gnlmaps;
+  trueTrkVars[TRKVAR::NINT]     = (Double_t) gnlintt;
+  trueTrkVars[TRKVAR::NTPC]     = (Double_t) gntpc;
+  trueTrkVars[TRKVAR::QUAL]     = quality;
+  trueTrkVars[TRKVAR::DCAXY]    = umDcaXY;
+  trueTrkVars[TRKVAR::DCAZ]     = umDcaZ;
+  trueTrkVars[TRKVAR::DELDCAXY] = deltaDcaXY;
+  trueTrkVars[TRKVAR::DELDCAZ]  = deltaDcaZ;
+  trueTrkVars[TRKVAR::NCLUST]   = nClust;
+  trueTrkVars[TRKVAR::AVGCLUST] = avgClust;
+
+  // set reco phys variables
+  recoPhysVars[PHYSVAR::PHI]    = phi;
+  recoPhysVars[PHYSVAR::ETA]    = eta;
+  recoPhysVars[PHYSVAR::PT]     = pt;
+  recoPhysVars[PHYSVAR::DELPHI] = deltaPhi;
+  recoPhysVars[PHYSVAR::DELETA] = deltaEta;
+  recoPhysVars[PHYSVAR::DELPT]  = deltaPt;
+
+  // set true phys variables
+  truePhysVars[PHYSVAR::PHI]    = gphi;
+  truePhysVars[PHYSVAR::ETA]    = geta;
+  truePhysVars[PHYSVAR::PT]     = gpt;
+  truePhysVars[PHYSVAR::DELPHI] = deltaPhi;
+  truePhysVars[PHYSVAR::DELETA] = deltaEta;
+  truePhysVars[PHYSVAR::DELPT]  = deltaPt;
+  return;
+
+}  // end 'CalculateEmbedVars(Double_t, Double_t, Double_t[], Double_t[], Double_t[], Double_t[])'
+
+
+
+void STrackCutStudy::ProcessCandidate(const Long64_t iOffset, const Long64_t iStart, const Bool_t doDiffs) {
+
+  // candidate tuple is read into the embed-only members, and its
+  // entries are checkpointed right after the embed-only ones
+  const Long64_t nEntries = ntCandEO -> GetEntries();
+  cout << "      Beginning candidate entry loop: " << nEntries << " entries to process..." << endl;
+
+  // arrays for filling histograms
+  Double_t recoTrkVars[NTrkVar];
+  Double_t trueTrkVars[NTrkVar];
+  Double_t recoPhysVars[NPhysVar];
+  Double_t truePhysVars[NPhysVar];
+
+  for (Long64_t iEntry = iStart; iEntry < nEntries; iEntry++) {
+
+    // checkpoint if needed (stops on SIGTERM)
+    iCurrent = iOffset + iEntry;
+    if (doCheckpoint && !CheckCheckpoint()) break;
+
+    // grab entry
+    const Long64_t bytes = ntCandEO -> GetEntry(iEntry);
+    if (bytes < 0.) {
+      cerr << "WARNING: something wrong with candidate entry #" << iEntry << "! Aborting loop!" << endl;
+      break;
+    }
+    evtMult = -1.;
+
+    // announce progress
+    const Long64_t iProg = iEntry + 1;
+    if (inBatchMode || (iProg == nEntries)) {
+      cout << "        Processing candidate entry " << iProg << "/" << nEntries << "..." << endl;
+    } else {
+      cout << "        Processing candidate entry " << iProg << "/" << nEntries << "...\r" << flush;
+    }
+
+    // clusters are only indexed for the baseline sample
+    CalculateEmbedVars(0., 0., recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+    // compare to same particle in baseline
+    if (doDiffs) FillPairedHists(PAIRMODE::PAIR_CAND, event, seed, gtrackID, recoTrkVars, recoPhysVars, truePhysVars[PHYSVAR::PT]);
+
+    // fill candidate histograms
+    const Bool_t isPrimary = (gprimary == 1);
+    if (doBeforeCuts) FillTrackHistograms(TYPE::CANDIDATE, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+
+    const Bool_t isGoodTrk = ApplyCuts(isPrimary, (UInt_t) nlmaps, (UInt_t) ntpc, vz, recoTrkVars[TRKVAR::DCAXY], recoTrkVars[TRKVAR::DCAZ], quality);
+    if (!isGoodTrk) continue;
+
+    FillTrackHistograms(TYPE::CAND_CUT, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+  }  // end candidate entry loop
+  cout << "      Finished candidate entry loop." << endl;
+  if (doDiffs) {
+    cout << "      Paired " << nPaired[PAIRMODE::PAIR_CAND] << " candidate tracks with " << pairIndex.size() << " baseline tracks." << endl;
+  }
+  return;
+
+}  // end 'ProcessCandidate(Long64_t, Long64_t, Bool_t)'
 
 // end ------------------------------------------------------------------------
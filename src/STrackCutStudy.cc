@@ -13,6 +13,7 @@
 
 // header files
 #include "STrackCutStudy.h"
+#include "../macros/HistogramReaders.h"
 #include "STrackCutStudy.io.h"
 #include "STrackCutStudy.ana.h"
 #include "STrackCutStudy.hist.h"
@@ -32,6 +33,24 @@ STrackCutStudy::STrackCutStudy() {
   nTxtEO          = 0;
   nTxtPU          = 0;
   inBatchMode     = false;
+  fOut            = NULL;
+  fInEO           = NULL;
+  fInPU           = NULL;
+  ntTrkEO         = NULL;
+  ntTrkPU         = NULL;
+  ntClustEO       = NULL;
+  ntTruEO         = NULL;
+  doEfficiency    = false;
+  doPairing       = false;
+  fInCand         = NULL;
+  ntCandEO        = NULL;
+  doCandidate     = false;
+  doClustSummary  = false;
+  doEventGroups   = false;
+  evtMult         = -1.;
+  doDupGhost      = false;
+  ghostPurityMin  = 0.5;
+  hDupMult        = NULL;
   makePlots       = false;
   doPileup        = false;
   doIntNorm       = false;
@@ -45,6 +64,37 @@ STrackCutStudy::STrackCutStudy() {
   doDcaXyCut      = false;
   doDcaZCut       = false;
   doQualityCut    = false;
+  compSettings    = -1;
+  nSaveThreads    = 1;
+  doSparseOutput  = false;
+  doPlotOnly      = false;
+  fInPlot         = NULL;
+  nPlotWorkers    = 1;
+  fPrevPlot       = NULL;
+  doImageExport   = false;
+  sImageDir       = "./plots";
+  doCheckpoint    = false;
+  doResume        = false;
+  fCheck          = NULL;
+  checkInterval   = 600.;
+  tLastCheck      = 0.;
+  iNextCheck      = 0;
+  iCurrent        = 0;
+  iResume         = 0;
+  isStopped       = false;
+  for (Int_t iType = 0; iType < NType; iType++) {
+    nDoneType[iType]   = 0;
+    isTypeDirty[iType] = false;
+  }
+  for (Ssiz_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+    doTrkVarPlot[iTrkVar] = true;
+  }
+  for (Ssiz_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+    doPhysVarPlot[iPhysVar] = true;
+  }
+  for (Ssiz_t iFam = 0; iFam < NPlotFam; iFam++) {
+    doFamFill[iFam] = true;
+  }
 
   // set whether or not type is truth
   isTruth[TYPE::TRACK]         = false;
@@ -65,6 +115,12 @@ STrackCutStudy::STrackCutStudy() {
   isTruth[TYPE::PILE_CUT]      = false;
   isTruth[TYPE::PRIM_CUT]      = false;
   isTruth[TYPE::NONPRIM_CUT]   = false;
+  isTruth[TYPE::DUPLICATE]     = false;
+  isTruth[TYPE::GHOST]         = false;
+  isTruth[TYPE::DUPL_CUT]      = false;
+  isTruth[TYPE::GHOST_CUT]     = false;
+  isTruth[TYPE::CANDIDATE]     = false;
+  isTruth[TYPE::CAND_CUT]      = false;
 
   // set whether or not type has pileup
   isPileup[TYPE::TRACK]         = false;
@@ -85,6 +141,12 @@ STrackCutStudy::STrackCutStudy() {
   isPileup[TYPE::PILE_CUT]      = true;
   isPileup[TYPE::PRIM_CUT]      = true;
   isPileup[TYPE::NONPRIM_CUT]   = true;
+  isPileup[TYPE::DUPLICATE]     = false;
+  isPileup[TYPE::GHOST]         = false;
+  isPileup[TYPE::DUPL_CUT]      = false;
+  isPileup[TYPE::GHOST_CUT]     = false;
+  isPileup[TYPE::CANDIDATE]     = false;
+  isPileup[TYPE::CAND_CUT]      = false;
 
   // set whether or not type is before cuts
   isBeforeCuts[TYPE::TRACK]         = true;
@@ -105,6 +167,64 @@ STrackCutStudy::STrackCutStudy() {
   isBeforeCuts[TYPE::PILE_CUT]      = false;
   isBeforeCuts[TYPE::PRIM_CUT]      = false;
   isBeforeCuts[TYPE::NONPRIM_CUT]   = false;
+  isBeforeCuts[TYPE::DUPLICATE]     = true;
+  isBeforeCuts[TYPE::GHOST]         = true;
+  isBeforeCuts[TYPE::DUPL_CUT]      = false;
+  isBeforeCuts[TYPE::GHOST_CUT]     = false;
+  isBeforeCuts[TYPE::CANDIDATE]     = true;
+  isBeforeCuts[TYPE::CAND_CUT]      = false;
+
+  // set whether or not type is from candidate sample
+  isCandidate[TYPE::TRACK]         = false;
+  isCandidate[TYPE::TRUTH]         = false;
+  isCandidate[TYPE::WEIRD_ALL]     = false;
+  isCandidate[TYPE::WEIRD_SI]      = false;
+  isCandidate[TYPE::WEIRD_TPC]     = false;
+  isCandidate[TYPE::NORMAL]        = false;
+  isCandidate[TYPE::PILEUP]        = false;
+  isCandidate[TYPE::PRIMARY]       = false;
+  isCandidate[TYPE::NONPRIM]       = false;
+  isCandidate[TYPE::TRK_CUT]       = false;
+  isCandidate[TYPE::TRU_CUT]       = false;
+  isCandidate[TYPE::WEIRD_CUT]     = false;
+  isCandidate[TYPE::WEIRD_SI_CUT]  = false;
+  isCandidate[TYPE::WEIRD_TPC_CUT] = false;
+  isCandidate[TYPE::NORM_CUT]      = false;
+  isCandidate[TYPE::PILE_CUT]      = false;
+  isCandidate[TYPE::PRIM_CUT]      = false;
+  isCandidate[TYPE::NONPRIM_CUT]   = false;
+  isCandidate[TYPE::DUPLICATE]     = false;
+  isCandidate[TYPE::GHOST]         = false;
+  isCandidate[TYPE::DUPL_CUT]      = false;
+  isCandidate[TYPE::GHOST_CUT]     = false;
+  isCandidate[TYPE::CANDIDATE]     = true;
+  isCandidate[TYPE::CAND_CUT]      = true;
+
+  // set whether or not type is a duplicate/ghost type
+  isDupGhost[TYPE::TRACK]          = false;
+  isDupGhost[TYPE::TRUTH]          = false;
+  isDupGhost[TYPE::WEIRD_ALL]      = false;
+  isDupGhost[TYPE::WEIRD_SI]       = false;
+  isDupGhost[TYPE::WEIRD_TPC]      = false;
+  isDupGhost[TYPE::NORMAL]         = false;
+  isDupGhost[TYPE::PILEUP]         = false;
+  isDupGhost[TYPE::PRIMARY]        = false;
+  isDupGhost[TYPE::NONPRIM]        = false;
+  isDupGhost[TYPE::TRK_CUT]        = false;
+  isDupGhost[TYPE::TRU_CUT]        = false;
+  isDupGhost[TYPE::WEIRD_CUT]      = false;
+  isDupGhost[TYPE::WEIRD_SI_CUT]   = false;
+  isDupGhost[TYPE::WEIRD_TPC_CUT]  = false;
+  isDupGhost[TYPE::NORM_CUT]       = false;
+  isDupGhost[TYPE::PILE_CUT]       = false;
+  isDupGhost[TYPE::PRIM_CUT]       = false;
+  isDupGhost[TYPE::NONPRIM_CUT]    = false;
+  isDupGhost[TYPE::DUPLICATE]      = true;
+  isDupGhost[TYPE::GHOST]          = true;
+  isDupGhost[TYPE::DUPL_CUT]       = true;
+  isDupGhost[TYPE::GHOST_CUT]      = true;
+  isDupGhost[TYPE::CANDIDATE]      = false;
+  isDupGhost[TYPE::CAND_CUT]       = false;
 
   // set whether or not track variable has a truth value
   trkVarHasTruVal[TRKVAR::VX]       = true;
@@ -149,6 +269,12 @@ STrackCutStudy::STrackCutStudy() {
   fTypeCol[TYPE::PILE_CUT]      = 923;
   fTypeCol[TYPE::PRIM_CUT]      = 859;
   fTypeCol[TYPE::NONPRIM_CUT]   = 799;
+  fTypeCol[TYPE::DUPLICATE]     = 819;
+  fTypeCol[TYPE::GHOST]         = 839;
+  fTypeCol[TYPE::DUPL_CUT]      = 819;
+  fTypeCol[TYPE::GHOST_CUT]     = 839;
+  fTypeCol[TYPE::CANDIDATE]     = 859;
+  fTypeCol[TYPE::CAND_CUT]      = 859;
 
   // set type markers
   fTypeMar[TYPE::TRACK]         = 20;
@@ -169,6 +295,12 @@ STrackCutStudy::STrackCutStudy() {
   fTypeMar[TYPE::PILE_CUT]      = 20;
   fTypeMar[TYPE::PRIM_CUT]      = 26;
   fTypeMar[TYPE::NONPRIM_CUT]   = 32;
+  fTypeMar[TYPE::DUPLICATE]     = 25;
+  fTypeMar[TYPE::GHOST]         = 27;
+  fTypeMar[TYPE::DUPL_CUT]      = 25;
+  fTypeMar[TYPE::GHOST_CUT]     = 27;
+  fTypeMar[TYPE::CANDIDATE]     = 21;
+  fTypeMar[TYPE::CAND_CUT]      = 21;
 
   // set type names
   sTrkNames[TYPE::TRACK]         = "AllTrack";
@@ -189,6 +321,12 @@ STrackCutStudy::STrackCutStudy() {
   sTrkNames[TYPE::PILE_CUT]      = "CutPileup";
   sTrkNames[TYPE::PRIM_CUT]      = "CutPrimePileup";
   sTrkNames[TYPE::NONPRIM_CUT]   = "CutNonPrimePileup"; 
+  sTrkNames[TYPE::DUPLICATE]     = "AllDuplicate";
+  sTrkNames[TYPE::GHOST]         = "AllGhost";
+  sTrkNames[TYPE::DUPL_CUT]      = "CutDuplicate";
+  sTrkNames[TYPE::GHOST_CUT]     = "CutGhost";
+  sTrkNames[TYPE::CANDIDATE]     = "AllCandidate";
+  sTrkNames[TYPE::CAND_CUT]      = "CutCandidate";
 
   // set type plot labels
   sTrkLabels[TYPE::TRACK]         = "Tracks (before cuts)";
@@ -209,6 +347,12 @@ STrackCutStudy::STrackCutStudy() {
   sTrkLabels[TYPE::PILE_CUT]      = "Including pileup tracks (all, after cuts)";
   sTrkLabels[TYPE::PRIM_CUT]      = "Including pileup tracks (only primary, after cuts)";
   sTrkLabels[TYPE::NONPRIM_CUT]   = "Including pileup gracks (non-primary, after cuts)";
+  sTrkLabels[TYPE::DUPLICATE]     = "Duplicate tracks (shared truth match, before cuts)";
+  sTrkLabels[TYPE::GHOST]         = "Ghost tracks (low truth purity, before cuts)";
+  sTrkLabels[TYPE::DUPL_CUT]      = "Duplicate tracks (shared truth match, after cuts)";
+  sTrkLabels[TYPE::GHOST_CUT]     = "Ghost tracks (low truth purity, after cuts)";
+  sTrkLabels[TYPE::CANDIDATE]     = "Candidate tracks (before cuts)";
+  sTrkLabels[TYPE::CAND_CUT]      = "Candidate tracks (after cuts)";
 
   // set track variable names
   sTrkVars[TRKVAR::VX]       = "Vx";
@@ -233,6 +377,47 @@ STrackCutStudy::STrackCutStudy() {
   sPhysVars[PHYSVAR::DELPHI] = "DeltaPhi";
   sPhysVars[PHYSVAR::DELETA] = "DeltaEta";
   sPhysVars[PHYSVAR::DELPT]  = "DeltaPt";
+
+  // set plot families (in the order they're drawn)
+  sPlotFams[0] = "";
+  sPlotFams[1] = "Diff";
+  sPlotFams[2] = "Frac";
+  sPlotFams[3] = "VsNTpc";
+  sPlotFams[4] = "VsDcaXY";
+  sPlotFams[5] = "VsDcaZ";
+  sPlotFams[6] = "VsPtReco";
+  sPlotFams[7] = "VsPtTrue";
+  sPlotFams[8] = "VsPtFrac";
+  sPlotFams[9] = "VsMult";
+
+  // set efficiency variables and cut levels
+  sEffVars[0]   = "Pt";
+  sEffVars[1]   = "Eta";
+  sEffVars[2]   = "Phi";
+  sEffVars[3]   = "NTpc";
+  sCutLevels[0] = "BeforeCuts";
+  sCutLevels[1] = "AfterCuts";
+  for (Ssiz_t iLevel = 0; iLevel < NCutLevel; iLevel++) {
+    for (Ssiz_t iEffVar = 0; iEffVar < NEffVar; iEffVar++) {
+      eTrkEff[iLevel][iEffVar]  = NULL;
+      eTrkFake[iLevel][iEffVar] = NULL;
+    }
+  }
+
+  // set pairing modes
+  sPairModes[PAIRMODE::PAIR_PU]   = "WithPileup";
+  sPairModes[PAIRMODE::PAIR_CAND] = "Candidate";
+  for (Ssiz_t iMode = 0; iMode < NPairMode; iMode++) {
+    nPaired[iMode] = 0;
+    for (Ssiz_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+      hPairTrkDiff[iMode][iTrkVar]         = NULL;
+      hPairTrkDiffVsPtTrue[iMode][iTrkVar] = NULL;
+    }
+    for (Ssiz_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+      hPairPhysDiff[iMode][iPhysVar]         = NULL;
+      hPairPhysDiffVsPtTrue[iMode][iPhysVar] = NULL;
+    }
+  }
   cout << "\n  Beginning track cut study."  << endl;
 
 }  // end ctor
@@ -260,9 +445,21 @@ void STrackCutStudy::Init() {
 
   // announce method
   cout << "    Initializing:" << endl;
+
+  // previous plots have to be set aside before the output is recreated
+  if (makePlots) InitPlotCache();
+
+  // only need saved histograms to make plots
+  if (doPlotOnly) {
+    InitPlotFiles();
+    return;
+  }
+
   InitFiles();
   InitTuples();
   InitHists();
+  if (doEfficiency) InitEfficiencies();
+  if (doCheckpoint || doResume) InitCheckpoint();
   MakeCutText();
   return;
 
@@ -284,8 +481,49 @@ void STrackCutStudy::Analyze() {
   }
   cout << "    Analyzing:" <<endl;
 
+  // index clusters by track if needed
+  if (doAvgClustCalc && !doClustSummary) DoClusterCalculation();
+
   // prepare for embed-only entry loop
   Long64_t nEntriesEO = ntTrkEO -> GetEntries();
+  if (doEventGroups) {
+    vector<Long64_t> eoEvtEntries;
+    vector<Long64_t> eoEvtStarts;
+    BuildEventIndex(ntTrkEO, event, seed, eoEvtEntries, eoEvtStarts);
+
+    // embed-only entries stay in tuple order, so just record each one's multiplicity
+    eoEntryMult.assign(nEntriesEO, 0);
+    for (size_t iEvt = 0; (iEvt + 1) < eoEvtStarts.size(); iEvt++) {
+      for (Long64_t iPos = eoEvtStarts[iEvt]; iPos < eoEvtStarts[iEvt + 1]; iPos++) {
+        eoEntryMult[eoEvtEntries[iPos]] = eoEvtStarts[iEvt + 1] - eoEvtStarts[iEvt];
+      }
+    }
+  }
+
+  // efficiencies need every embed-only entry
+  if (doEfficiency && (iResume > 0)) {
+    cerr << "WARNING: resuming from entry #" << iResume << ", efficiencies won't be calculated!" << endl;
+    doEfficiency = false;
+  }
+  if (doEfficiency) BuildTruthIndex();
+
+  // pairing needs every embed-only entry and the pileup sample
+  if (doPairing && (iResume > 0)) {
+    cerr << "WARNING: resuming from entry #" << iResume << ", paired differences won't be calculated!" << endl;
+    doPairing = false;
+  }
+  if (doPairing && !doPileup) {
+    cerr << "WARNING: not looking at pileup tuple, paired differences won't be calculated!" << endl;
+    doPairing = false;
+  }
+
+  // find tracks sharing a truth match
+  if (doDupGhost) {
+    FindDuplicates(ntTrkEO, event, seed, gtrackID, eoEntryDupMult);
+    for (const UInt_t dupMult : eoEntryDupMult) {
+      if (dupMult > 0) hDupMult -> Fill(dupMult, 1. / dupMult);
+    }
+  }
   cout << "      Beginning embed-only entry loop: " << nEntriesEO << " entries to process..." << endl;
 
   // arrays for filling histograms
@@ -296,7 +534,11 @@ void STrackCutStudy::Analyze() {
 
   // loop over embed-only tuple entries
   Long64_t nBytesEO(0);
-  for (Long64_t iEntry = 0; iEntry < nEntriesEO; iEntry++) {
+  for (Long64_t iEntry = iResume; iEntry < nEntriesEO; iEntry++) {
+
+    // checkpoint if needed (stops on SIGTERM)
+    iCurrent = iEntry;
+    if (doCheckpoint && !CheckCheckpoint()) break;
 
     // grab entry
     const Long64_t bytesEO = ntTrkEO -> GetEntry(iEntry);
@@ -305,6 +547,7 @@ void STrackCutStudy::Analyze() {
       break;
     }
     nBytesEO += bytesEO;
+    evtMult   = doEventGroups ? (Double_t) eoEntryMult[iEntry] : -1.;
 
     // announce progress
     const Long64_t iProg = iEntry + 1;
@@ -318,63 +561,24 @@ void STrackCutStudy::Analyze() {
       }
     }
 
-    // perform calculations
-    const Double_t umDcaXY    = dca3dxy * 10000;
-    const Double_t umDcaZ     = dca3dz * 10000;
-    const Double_t deltaDcaXY = abs(dca3dxy / dca3dxysigma);
-    const Double_t deltaDcaZ  = abs(dca3dz / dca3dzsigma);
-    const Double_t deltaEta   = abs(deltaeta / eta);
-    const Double_t deltaPhi   = abs(deltaphi / phi);
-    const Double_t deltaPt    = abs(deltapt / pt);
-    const Double_t ptFrac     = pt /gpt;
-
-    // set reco track variables
-    recoTrkVars[TRKVAR::VX]       = vx;
-    recoTrkVars[TRKVAR::VY]       = vy;
-    recoTrkVars[TRKVAR::VZ]       = vz;
-    recoTrkVars[TRKVAR::NMMS]     = (Double_t) nlmms;
-    recoTrkVars[TRKVAR::NMAP]     = (Double_t) nlmaps;
-    recoTrkVars[TRKVAR::NINT]     = (Double_t) nlintt;
-    recoTrkVars[TRKVAR::NTPC]     = (Double_t) ntpc;
-    recoTrkVars[TRKVAR::QUAL]     = quality;
-    recoTrkVars[TRKVAR::DCAXY]    = umDcaXY;
-    recoTrkVars[TRKVAR::DCAZ]     = umDcaZ;
-    recoTrkVars[TRKVAR::DELDCAXY] = deltaDcaXY;
-    recoTrkVars[TRKVAR::DELDCAZ]  = deltaDcaZ;
-    recoTrkVars[TRKVAR::NCLUST]   = 0.;
-    recoTrkVars[TRKVAR::AVGCLUST] = 0.;
-
-    // set true track variables
-    trueTrkVars[TRKVAR::VX]       = gvx;
-    trueTrkVars[TRKVAR::VY]       = gvy;
-    trueTrkVars[TRKVAR::VZ]       = gvz;
-    trueTrkVars[TRKVAR::NMMS]     = (Double_t) gnlmms;
-    trueTrkVars[TRKVAR::NMAP]     = (Double_t) gnlmaps;
-    trueTrkVars[TRKVAR::NINT]     = (Double_t) gnlintt;
-    trueTrkVars[TRKVAR::NTPC]     = (Double_t) gntpc;
-    trueTrkVars[TRKVAR::QUAL]     = quality;
-    trueTrkVars[TRKVAR::DCAXY]    = umDcaXY;
-    trueTrkVars[TRKVAR::DCAZ]     = umDcaZ;
-    trueTrkVars[TRKVAR::DELDCAXY] = deltaDcaXY;
-    trueTrkVars[TRKVAR::DELDCAZ]  = deltaDcaZ;
-    trueTrkVars[TRKVAR::NCLUST]   = 0.;
-    trueTrkVars[TRKVAR::AVGCLUST] = 0.;
-
-    // set reco phys variables
-    recoPhysVars[PHYSVAR::PHI]    = phi;
-    recoPhysVars[PHYSVAR::ETA]    = eta;
-    recoPhysVars[PHYSVAR::PT]     = pt;
-    recoPhysVars[PHYSVAR::DELPHI] = deltaPhi;
-    recoPhysVars[PHYSVAR::DELETA] = deltaEta;
-    recoPhysVars[PHYSVAR::DELPT]  = deltaPt;
-
-    // set true phys variables
-    truePhysVars[PHYSVAR::PHI]    = gphi;
-    truePhysVars[PHYSVAR::ETA]    = geta;
-    truePhysVars[PHYSVAR::PT]     = gpt;
-    truePhysVars[PHYSVAR::DELPHI] = deltaPhi;
-    truePhysVars[PHYSVAR::DELETA] = deltaEta;
-    truePhysVars[PHYSVAR::DELPT]  = deltaPt;
+    // look up clusters on track
+    Double_t nClust(0.);
+    Double_t avgClust(0.);
+    if (doClustSummary) {
+      nClust   = cs_nclust;
+      avgClust = cs_avgclustsize;
+    } else if (doAvgClustCalc) {
+      GetTrackClusters(event, seed, trackID, nClust, avgClust);
+    }
+
+    // set track and physics variables
+    CalculateEmbedVars(nClust, avgClust, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+    const Double_t umDcaXY = recoTrkVars[TRKVAR::DCAXY];
+    const Double_t umDcaZ  = recoTrkVars[TRKVAR::DCAZ];
+    const Double_t ptFrac  = pt / gpt;
+
+    // keep reco values for pairing with pileup or candidate sample
+    if (doPairing || doCandidate) AddPairedTrack(event, seed, gtrackID, recoTrkVars, recoPhysVars);
 
     // check for weird tracks
     const Bool_t hasSiSeed    = (nmaps == 3);
@@ -382,6 +586,10 @@ void STrackCutStudy::Analyze() {
     const Bool_t isPrimary    = (gprimary == 1);
     const Bool_t isWeirdTrack = ((ptFrac < normalPtFracMin) || (ptFrac > normalPtFracMax));
 
+    // check for duplicate and ghost tracks
+    const Bool_t isDuplicate = doDupGhost && (eoEntryDupMult[iEntry] > 1);
+    const Bool_t isGhost     = doDupGhost && ((nhits <= 0.) || ((nfromtruth / nhits) < ghostPurityMin));
+
     // fill all track histograms
     if (doBeforeCuts) {
       FillTrackHistograms(TYPE::TRACK, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
@@ -395,10 +603,21 @@ void STrackCutStudy::Analyze() {
       } else {
         FillTrackHistograms(TYPE::NORMAL, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
       }
+
+      // fill all embed_only duplicate/ghost histograms
+      if (isDuplicate) FillTrackHistograms(TYPE::DUPLICATE, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+      if (isGhost)     FillTrackHistograms(TYPE::GHOST,     recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
     }
 
     // apply cuts
     const Bool_t isGoodTrk = ApplyCuts(isPrimary, (UInt_t) nlmaps, (UInt_t) ntpc, vz, umDcaXY, umDcaZ, quality);
+
+    // join to truth particle
+    if (doEfficiency) {
+      const Double_t recoEffVars[NEffVar] = {pt, eta, phi, (Double_t) ntpc};
+      const Double_t purity               = (nhits > 0.) ? (nfromtruth / nhits) : 0.;
+      MatchTrackToTruth(recoEffVars, purity, isGoodTrk);
+    }
     if (!isGoodTrk) continue;
 
     // fill cut track histograms
@@ -413,129 +632,105 @@ void STrackCutStudy::Analyze() {
     } else {
       FillTrackHistograms(TYPE::NORM_CUT, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
     }
+
+    // fill cut embed_only duplicate/ghost histograms
+    if (isDuplicate) FillTrackHistograms(TYPE::DUPL_CUT,  recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
+    if (isGhost)     FillTrackHistograms(TYPE::GHOST_CUT, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
   }  // end embed-only entry loop
   cout << "      Finished embed-only entry loop." << endl;
 
+  // on SIGTERM the checkpoint holds everything so far
+  if (isStopped) {
+    CloseCheckpoint();
+    return;
+  }
+
+  // fill efficiencies from joined truth particles
+  if (doEfficiency) FillEfficiencies();
+
+  // candidate sample is done once the embed-only (baseline) sample is
+  const Long64_t nEntriesCand = doCandidate ? ntCandEO -> GetEntries() : 0;
+  if (doCandidate && (iResume < (nEntriesEO + nEntriesCand))) {
+    if (iResume > 0) {
+      cerr << "WARNING: resuming from entry #" << iResume << ", candidate differences won't be calculated!" << endl;
+    }
+    const Long64_t iStartCand = (iResume > nEntriesEO) ? (iResume - nEntriesEO) : 0;
+    ProcessCandidate(nEntriesEO, iStartCand, (iResume == 0));
+
+    // on SIGTERM the checkpoint holds everything so far
+    if (isStopped) {
+      CloseCheckpoint();
+      return;
+    }
+  }
+
+  // with-pileup entries are checkpointed after the embed-only and candidate ones
+  const Long64_t nEntriesPre = nEntriesEO + nEntriesCand;
+
   // prepare for with-pileup entry loop
   if (doPileup) {
     Long64_t nEntriesPU = ntTrkPU -> GetEntries();
+    if (doEventGroups) BuildEventIndex(ntTrkPU, pu_event, pu_seed, puEvtEntries, puEvtStarts);
     cout << "      Beginning with-pileup entry loop: " << nEntriesPU << " entries to process..." << endl;
 
-    // loop over with-pileup tuple entries
+    // loop over with-pileup tuple entries: in grouped mode entries are
+    // delivered event by event, and the position in the index is what's
+    // checkpointed
     Long64_t nBytesPU(0);
-    for (Long64_t iEntry = 0; iEntry < nEntriesPU; iEntry++) {
-
-      // grab entry
-      const Long64_t bytesPU = ntTrkPU -> GetEntry(iEntry);
-      if (bytesPU < 0.) {
-        cerr << "WARNING: something wrong with with-pileup entry #" << iEntry << "! Aborting loop!" << endl;
-        break;
-      }
-      nBytesPU += bytesPU;
-
-      // announce progress
-      const Long64_t iProg = iEntry + 1;
-      if (inBatchMode) {
-        cout << "        Processing with-pileup entry " << iProg << "/" << nEntriesPU << "..." << endl;
-      } else {
-        if (iProg == nEntriesPU) {
-          cout << "        Processing with-pileup entry " << iProg << "/" << nEntriesPU << "..." << endl;
-        } else {
-          cout << "        Processing with-pileup entry " << iProg << "/" << nEntriesPU << "...\r" << flush;
+    Bool_t   isLoopGood(true);
+    const Long64_t iStartPU = (iResume > nEntriesPre) ? (iResume - nEntriesPre) : 0;
+    if (doEventGroups) {
+      const Long64_t nEventsPU = puEvtStarts.size() - 1;
+      for (Long64_t iEvt = 0; (iEvt < nEventsPU) && isLoopGood; iEvt++) {
+        const Long64_t iFirst = puEvtStarts[iEvt];
+        const Long64_t iLast  = puEvtStarts[iEvt + 1];
+        if (iLast <= iStartPU) continue;
+
+        evtMult = (Double_t) (iLast - iFirst);
+        for (Long64_t iPos = max(iFirst, iStartPU); iPos < iLast; iPos++) {
+
+          // checkpoint if needed (stops on SIGTERM)
+          iCurrent = nEntriesPre + iPos;
+          if (doCheckpoint && !CheckCheckpoint()) {
+            isLoopGood = false;
+            break;
+          }
+
+          const Long64_t bytesPU = ProcessPileupEntry(puEvtEntries[iPos], iPos + 1, nEntriesPU);
+          if (bytesPU < 0) {
+            isLoopGood = false;
+            break;
+          }
+          nBytesPU += bytesPU;
         }
-      }
-
-      // perform calculations
-      const Double_t umDcaXY    = pu_dca3dxy * 10000;
-      const Double_t umDcaZ     = pu_dca3dz * 10000;
-      const Double_t deltaDcaXY = abs(pu_dca3dxy / pu_dca3dxysigma);
-      const Double_t deltaDcaZ  = abs(pu_dca3dz / pu_dca3dzsigma);
-      const Double_t deltaEta   = abs(pu_deltaeta / pu_eta);
-      const Double_t deltaPhi   = abs(pu_deltaphi / pu_phi);
-      const Double_t deltaPt    = abs(pu_deltapt / pu_pt);
-
-      // check if values are defined
-      const Bool_t thereAreNans = (isnan(pu_dca3dxy) || isnan(pu_dca3dz) || isnan(pu_eta) || isnan(pu_phi) || isnan(pu_pt));
-      if (thereAreNans) continue;
-
-      // set reco track variables
-      recoTrkVars[TRKVAR::VX]       = pu_vx;
-      recoTrkVars[TRKVAR::VY]       = pu_vy;
-      recoTrkVars[TRKVAR::VZ]       = pu_vz;
-      recoTrkVars[TRKVAR::NMMS]     = (Double_t) pu_nlmms;
-      recoTrkVars[TRKVAR::NMAP]     = (Double_t) pu_nlmaps;
-      recoTrkVars[TRKVAR::NINT]     = (Double_t) pu_nlintt;
-      recoTrkVars[TRKVAR::NTPC]     = (Double_t) pu_ntpc;
-      recoTrkVars[TRKVAR::QUAL]     = pu_quality;
-      recoTrkVars[TRKVAR::DCAXY]    = umDcaXY;
-      recoTrkVars[TRKVAR::DCAZ]     = umDcaZ;
-      recoTrkVars[TRKVAR::DELDCAXY] = deltaDcaXY;
-      recoTrkVars[TRKVAR::DELDCAZ]  = deltaDcaZ;
-      recoTrkVars[TRKVAR::NCLUST]   = 0.;
-      recoTrkVars[TRKVAR::AVGCLUST] = 0.;
-
-      // set true track variables
-      trueTrkVars[TRKVAR::VX]       = pu_gvx;
-      trueTrkVars[TRKVAR::VY]       = pu_gvy;
-      trueTrkVars[TRKVAR::VZ]       = pu_gvz;
-      trueTrkVars[TRKVAR::NMMS]     = (Double_t) pu_gnlmms;
-      trueTrkVars[TRKVAR::NMAP]     = (Double_t) pu_gnlmaps;
-      trueTrkVars[TRKVAR::NINT]     = (Double_t) pu_gnlintt;
-      trueTrkVars[TRKVAR::NTPC]     = (Double_t) pu_gntpc;
-      trueTrkVars[TRKVAR::QUAL]     = pu_quality;
-      trueTrkVars[TRKVAR::DCAXY]    = umDcaXY;
-      trueTrkVars[TRKVAR::DCAZ]     = umDcaZ;
-      trueTrkVars[TRKVAR::DELDCAXY] = deltaDcaXY;
-      trueTrkVars[TRKVAR::DELDCAZ]  = deltaDcaZ;
-      trueTrkVars[TRKVAR::NCLUST]   = 0.;
-      trueTrkVars[TRKVAR::AVGCLUST] = 0.;
-
-      // set reco phys variables
-      recoPhysVars[PHYSVAR::PHI]    = pu_phi;
-      recoPhysVars[PHYSVAR::ETA]    = pu_eta;
-      recoPhysVars[PHYSVAR::PT]     = pu_pt;
-      recoPhysVars[PHYSVAR::DELPHI] = deltaPhi;
-      recoPhysVars[PHYSVAR::DELETA] = deltaEta;
-      recoPhysVars[PHYSVAR::DELPT]  = deltaPt;
-
-      // set true phys variables
-      truePhysVars[PHYSVAR::PHI]    = gphi;
-      truePhysVars[PHYSVAR::ETA]    = geta;
-      truePhysVars[PHYSVAR::PT]     = gpt;
-      truePhysVars[PHYSVAR::DELPHI] = deltaPhi;
-      truePhysVars[PHYSVAR::DELETA] = deltaEta;
-      truePhysVars[PHYSVAR::DELPT]  = deltaPt;
-
-      // check for primary tracks
-      const Bool_t isPrimary = (pu_gprimary == 1);
-
-      // fill all histograms
-      if (doBeforeCuts) {
-        FillTrackHistograms(TYPE::PILEUP, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-        if (isPrimary) {
-          FillTrackHistograms(TYPE::PRIMARY, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-        } else {
-          FillTrackHistograms(TYPE::NONPRIM, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-        }
-      }
+      }  // end with-pileup event loop
+    } else {
+      for (Long64_t iEntry = iStartPU; iEntry < nEntriesPU; iEntry++) {
 
-      // apply cuts
-      const Bool_t isGoodTrk = ApplyCuts(isPrimary, (UInt_t) pu_nlmaps, (UInt_t) pu_ntpc, pu_vz, umDcaXY, umDcaZ, pu_quality);
-      if (!isGoodTrk) continue;
+        // checkpoint if needed (stops on SIGTERM)
+        iCurrent = nEntriesPre + iEntry;
+        if (doCheckpoint && !CheckCheckpoint()) break;
 
-      // fill cut histograms
-      FillTrackHistograms(TYPE::PILE_CUT, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-      if (isPrimary) {
-        FillTrackHistograms(TYPE::PRIM_CUT, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-      } else {
-        FillTrackHistograms(TYPE::NONPRIM_CUT, recoTrkVars, trueTrkVars, recoPhysVars, truePhysVars);
-      }
-    }  // end with-pileup entry loop
+        const Long64_t bytesPU = ProcessPileupEntry(iEntry, iEntry + 1, nEntriesPU);
+        if (bytesPU < 0) break;
+        nBytesPU += bytesPU;
+      }  // end with-pileup entry loop
+    }
     cout << "      Finished with-pileup entry loop." << endl;
+    if (doPairing) {
+      cout << "      Paired " << nPaired[PAIRMODE::PAIR_PU] << " with-pileup tracks with " << pairIndex.size() << " embed-only tracks." << endl;
+    }
+    if (!isStopped) iCurrent = nEntriesPre + nEntriesPU;
+  } else {
+    iCurrent = nEntriesPre;
   }  // end if (doPileup)
+  pairIndex.clear();
+
+  // write final checkpoint
+  CloseCheckpoint();
 
   // normalize histograms if needed
-  if (doIntNorm) NormalizeHists();
+  if (doIntNorm && !isStopped) NormalizeHists();
   return;
 
 }  // end Analyze()
@@ -547,57 +742,59 @@ void STrackCutStudy::End() {
   // announce method
   cout << "    Ending:" << endl;
 
-  // set histogram styles
-  SetHistStyles();
-
-  // plot labels/directories to save in
-  if (makePlots) {
-    const TString sLabelAllEO("EmbedOnly_BeforeCuts");
-    const TString sLabelCutEO("EmbedOnly_AfterCuts");
-    const TString sLabelOddEO("EmbedOnly_WeirdVsNormal");
-    const TString sLabelAllPU("WithPileup_BeforeCuts");
-    const TString sLabelCutPU("WithPileup_AfterCuts");
-    const TString sDirPlotAllEO("EmbedOnlyPlots_BeforeCuts");
-    const TString sDirPlotCutEO("EmbedOnlyPlots_AfterCuts");
-    const TString sDirPlotOddEO("EmbedOnlyPlots_WeirdVsNormal");
-    const TString sDirPlotAllPU("AllWithPileupPlots");
-    const TString sDirPlotCutPU("CutWithPileupPlots");
-
-    // track types to plot together
-    const Ssiz_t nToDrawAllEO(3);
-    const Ssiz_t nToDrawCutEO(3);
-    const Ssiz_t nToDrawOddEO(3);
-    const Ssiz_t nToDrawAllPU(3);
-    const Ssiz_t nToDrawCutPU(3);
-    const Int_t  sToDrawAllEO[nToDrawAllEO] = {TYPE::TRACK,        TYPE::TRUTH,         TYPE::WEIRD_ALL};
-    const Int_t  sToDrawCutEO[nToDrawCutEO] = {TYPE::TRK_CUT,      TYPE::TRU_CUT,       TYPE::WEIRD_CUT};
-    const Int_t  sToDrawOddEO[nToDrawOddEO] = {TYPE::WEIRD_SI_CUT, TYPE::WEIRD_TPC_CUT, TYPE::NORM_CUT};
-    const Int_t  sToDrawAllPU[nToDrawAllPU] = {TYPE::PILEUP,       TYPE::PRIMARY,       TYPE::NONPRIM};
-    const Int_t  sToDrawCutPU[nToDrawCutPU] = {TYPE::PILE_CUT,     TYPE::PRIM_CUT,      TYPE::NONPRIM_CUT};
-
-    // create desired plots
-    ConstructPlots(nToDrawCutEO, sToDrawCutEO, sDirPlotCutEO, sLabelCutEO);
-    ConstructPlots(nToDrawOddEO, sToDrawOddEO, sDirPlotOddEO, sLabelOddEO);
-    if (doBeforeCuts) {
-      ConstructPlots(nToDrawAllEO, sToDrawAllEO, sDirPlotAllEO, sLabelAllEO);
-    }
-    if (doPileup) {
-      ConstructPlots(nToDrawCutPU, sToDrawCutPU, sDirPlotCutPU, sLabelCutPU);
-      if (doBeforeCuts) ConstructPlots(nToDrawAllPU, sToDrawAllPU, sDirPlotAllPU, sLabelAllPU);
-    }
-    cout << "      Created plots." << endl;
+  // a run stopped by SIGTERM only has partial histograms (they're in the checkpoint)
+  if (isStopped) {
+    cerr << "WARNING: run was stopped at entry " << iCurrent << ", not making plots or saving histograms! Resume from '" << sCheckFile.Data() << "'." << endl;
+  }
+
+  // set histogram styles (histograms are styled as they're loaded in plot-only mode)
+  if (!doPlotOnly) SetHistStyles();
+
+  // create desired plots
+  if (makePlots && !isStopped) {
+    TStopwatch swPlot;
+    swPlot.Start();
+    MakePlots();
+    if (doCandidate && !doPlotOnly) MakeCandidateRatios();
+    ClosePlotCache();
+    swPlot.Stop();
+    cout << "      Created plots in " << swPlot.RealTime() << " s (real)." << endl;
   }
 
   // save histograms
-  SaveHists();
-
-  // close files
-  fOut  -> cd();
-  fOut  -> Close();
-  fInEO -> cd();
-  fInEO -> Close();
-  fInPU -> cd();
-  fInPU -> Close();
+  if (!doPlotOnly && !isStopped) {
+    TStopwatch swSave;
+    swSave.Start();
+    SaveHists();
+    swSave.Stop();
+    cout << "      Saving took " << swSave.RealTime() << " s (real), " << swSave.CpuTime() << " s (cpu)." << endl;
+  }
+
+  // close files (output is closed by merger in parallel mode)
+  if (fOut) {
+    fOut -> cd();
+    fOut -> Close();
+  }
+  if (fInEO) {
+    fInEO -> cd();
+    fInEO -> Close();
+  }
+  if (fInPU) {
+    fInPU -> cd();
+    fInPU -> Close();
+  }
+  if (fInCand) {
+    fInCand -> cd();
+    fInCand -> Close();
+  }
+  if (fInPlot) {
+    fInPlot -> cd();
+    fInPlot -> Close();
+  }
+  if (fPrevPlot) {
+    fPrevPlot -> cd();
+    fPrevPlot -> Close();
+  }
   cout << "      Closed files.\n"
        << "  Finished track cut study!\n"
        << endl;
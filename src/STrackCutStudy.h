@@ -14,40 +14,76 @@
 
 // standard c includes
 #include <cmath>
+#include <map>
 #include <vector>
 #include <cassert>
 #include <cstdlib>
+#include <csignal>
+#include <memory>
+#include <fstream>
 #include <utility>
 #include <iostream>
+#include <unordered_map>
 // root includes
 #include <TH1.h>
 #include <TH2.h>
+#include <THnSparse.h>
+#include <TEfficiency.h>
 #include <TPad.h>
 #include <TFile.h>
 #include <TMath.h>
+#include <TROOT.h>
 #include <TError.h>
 #include <TNtuple.h>
+#include <TBranch.h>
+#include <TObjArray.h>
+#include <TFriendElement.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TLegend.h>
+#include <TLegendEntry.h>
+#include <TImage.h>
+#include <TNamed.h>
+#include <TMD5.h>
+#include <TText.h>
 #include <TCanvas.h>
 #include <TPaveText.h>
+#include <TTimeStamp.h>
+#include <TParameter.h>
 #include <TDirectory.h>
+#include <TStopwatch.h>
+#include <Compression.h>
+#include <ROOT/TBufferMerger.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#include <ROOT/TProcessExecutor.hxx>
+#include <ROOT/TSeq.hxx>
 
 using namespace std;
 
 // global constants
 static const Ssiz_t NVtx(4);
-static const Ssiz_t NType(18);
+static const Ssiz_t NType(24);
 static const Ssiz_t NTrkVar(14);
 static const Ssiz_t NPhysVar(6);
 static const Ssiz_t NRange(2);
 static const Ssiz_t NPanel(2);
+static const Ssiz_t NPlotFam(10);
+static const Ssiz_t NPlotGroup(9);
+static const Ssiz_t NGroupType(3);
+static const Ssiz_t NEffVar(4);
+static const Ssiz_t NCutLevel(2);
+static const Ssiz_t NPairMode(2);
 static const UInt_t FTxt(42);
+static const Int_t  NMaxScatBins(100);
+static const UInt_t FThumbWidth(250);
 
 
 
 class STrackCutStudy {
 
+  // microbenchmarks drive the private kernels directly [STrackCutStudyBench.cc]
+  friend class STrackCutStudyBench;
+
   public:
 
     // enums
@@ -93,7 +129,29 @@ class STrackCutStudy {
       NORM_CUT      = 14,
       PILE_CUT      = 15,
       PRIM_CUT      = 16,
-      NONPRIM_CUT   = 17
+      NONPRIM_CUT   = 17,
+      DUPLICATE     = 18,
+      GHOST         = 19,
+      DUPL_CUT      = 20,
+      GHOST_CUT     = 21,
+      CANDIDATE     = 22,
+      CAND_CUT      = 23
+    };
+    enum PAIRMODE {
+      PAIR_PU   = 0,
+      PAIR_CAND = 1
+    };
+    enum PLOTFAM {
+      FAM_SPEC     = 0,
+      FAM_DIFF     = 1,
+      FAM_FRAC     = 2,
+      FAM_VSNTPC   = 3,
+      FAM_VSDCAXY  = 4,
+      FAM_VSDCAZ   = 5,
+      FAM_VSPTRECO = 6,
+      FAM_VSPTTRUE = 7,
+      FAM_VSPTFRAC = 8,
+      FAM_VSMULT   = 9
     };
 
     // ctor/dtor
@@ -104,10 +162,25 @@ class STrackCutStudy {
     void SetBatchMode(const Bool_t doBatch=false);
     void SetInputOutputFiles(const TString sEmbedOnlyInput, const TString sPileupInput, const TString sOutput);
     void SetInputTuples(const TString sEmbedOnlyTuple, const TString sPileupTuple, const TString sEmbedOnlyClusterTuple="");
+    void SetClusterSummary(const TString sSummaryFile, const TString sSummaryTuple="ntp_clustsum");
+    void SetEventGrouping(const Bool_t groupEvents=true);
+    void SetDupGhost(const Bool_t dupGhost=true);
+    void SetGhostParameters(const Double_t purityMin);
+    void SetTruthTuple(const TString sTruthTuple="ntp_gtrack");
+    void SetPairedMode(const Bool_t pairSamples=true);
+    void SetCandidateInput(const TString sCandidateInput, const TString sCandidateTuple="ntp_track");
     void SetStudyParameters(const Bool_t plots, const Bool_t pileup, const Bool_t intNorm, const Bool_t beforeCuts, const Bool_t avgClustCalc, const Double_t weirdFracMin, const Double_t weirdFracMax);
     void SetCutFlags(const Bool_t doPrimary, const Bool_t doTpc, const Bool_t doMVtx, const Bool_t doVz, const Bool_t doDcaXY, const Bool_t doDcaZ, const Bool_t doQuality);
     void SetTrackCuts(const pair<UInt_t, UInt_t> nMVtxRange, const pair<UInt_t, UInt_t> nTpcRange, const pair<Double_t, Double_t> vzRange, const pair<Double_t, Double_t> dcaXyRange, const pair <Double_t, Double_t> dcaZRange, const pair<Double_t, Double_t> qualityRange);
     void SetPlotText(const Ssiz_t nTxtE, const Ssiz_t nTxtP, const TString sTxtE[], const TString sTxtP[]);
+    void SetOutputParameters(const Int_t compAlgo, const Int_t compLevel, const UInt_t nThreads=1);
+    void SetCheckpointParameters(const Bool_t checkpoint, const Bool_t resume, const TString sCheckpoint, const Double_t interval=600.);
+    void SetSparseOutput(const Bool_t sparse=true);
+    void SetRebinPyramid(const vector<UInt_t> levels);
+    void SetFillFamilies(const vector<TString> families);
+    void SetPlotOnly(const TString sStudyOutput);
+    void SetPlotParameters(const UInt_t nWorkers, const Bool_t exportImages=false, const TString sImages="./plots");
+    void SetPlotCache(const TString sPrevious);
     void Init();
     void Analyze();
     void End();
@@ -128,11 +201,102 @@ class STrackCutStudy {
     TNtuple *ntTrkEO;
     TNtuple *ntTrkPU;
     TNtuple *ntClustEO;
+    TNtuple *ntTruEO;
+    TFile   *fInCand;
+    TNtuple *ntCandEO;
+    TString  sInFileCand;
+    TString  sInTupleCand;
+    Bool_t   doCandidate;
+    TString  sInTruthEO;
+    Bool_t   doEfficiency;
+    TString  sClustSumFile;
+    TString  sClustSumTuple;
+    Bool_t   doClustSummary;
+    TFile   *fInPlot;
+    TString  sInPlot;
+    Bool_t   doPlotOnly;
+
+    // output parameters
+    Int_t          compSettings;
+    UInt_t         nSaveThreads;
+    Bool_t         doSparseOutput;
+    vector<UInt_t> pyramidLevels;
+
+    // plot parameters
+    UInt_t   nPlotWorkers;
+    Bool_t   doImageExport;
+    TString  sImageDir;
+    Bool_t   doTrkVarPlot[NTrkVar];
+    Bool_t   doPhysVarPlot[NPhysVar];
+    TFile   *fPrevPlot;
+    TString  sPrevPlot;
+
+    // checkpoint parameters
+    Bool_t   doCheckpoint;
+    Bool_t   doResume;
+    TFile   *fCheck;
+    TString  sCheckFile;
+    Double_t checkInterval;
+    Double_t tLastCheck;
+    Int_t    iNextCheck;
+    Long64_t iCurrent;
+    Long64_t iResume;
+    Long64_t nDoneType[NType];
+    Bool_t   isTypeDirty[NType];
+    Bool_t   isStopped;
+
+    // no. of entries of each histogram at its last checkpoint write
+    vector<Double_t> nCheckEntries[NType];
+
+    // track key: (event, seed, track ID)
+    struct TrackKey {
+      Long64_t event;
+      Long64_t seed;
+      Long64_t track;
+      Bool_t operator==(const TrackKey &other) const {
+        return ((event == other.event) && (seed == other.seed) && (track == other.track));
+      }
+    };
+    struct TrackKeyHash {
+      size_t operator()(const TrackKey &key) const {
+        size_t hash = std::hash<Long64_t>()(key.event);
+        hash = (hash * 1000003) ^ std::hash<Long64_t>()(key.seed);
+        hash = (hash * 1000003) ^ std::hash<Long64_t>()(key.track);
+        return hash;
+      }
+    };
+
+    // cluster index: track --> clusters on track
+    struct ClusterSum {
+      UInt_t   nClust;
+      Double_t sumSize;
+    };
+    unordered_map<TrackKey, ClusterSum, TrackKeyHash> clustIndex;
+
+    // truth index: (event, seed, gtrackID) --> truth particle
+    struct TruthMatch {
+      Float_t effVars[NEffVar];
+      Bool_t  isPrimary;
+      Bool_t  isFound[NCutLevel];
+    };
+    unordered_map<TrackKey, TruthMatch, TrackKeyHash> truthIndex;
+
+    // paired index: (event, seed, gtrackID) --> embed-only (baseline) reco values
+    struct PairedTrack {
+      Float_t trkVars[NTrkVar];
+      Float_t physVars[NPhysVar];
+    };
+    unordered_map<TrackKey, PairedTrack, TrackKeyHash> pairIndex;
+
+    // set by SIGTERM handler
+    static volatile sig_atomic_t gotTermSignal;
 
     // track type/variable names/styles/labels [set in ctor, *.cc]
     Bool_t  isTruth[NType];
     Bool_t  isPileup[NType];
     Bool_t  isBeforeCuts[NType];
+    Bool_t  isCandidate[NType];
+    Bool_t  isDupGhost[NType];
     Bool_t  trkVarHasTruVal[NTrkVar];
     Bool_t  physVarHasTruVal[NPhysVar];
     UInt_t  fTypeCol[NType];
@@ -141,6 +305,7 @@ class STrackCutStudy {
     TString sTrkLabels[NType];
     TString sTrkVars[NTrkVar];
     TString sPhysVars[NPhysVar];
+    TString sPlotFams[NPlotFam];
 
     // track-variable histograms
     TH1D *hTrkVar[NType][NTrkVar];
@@ -152,6 +317,7 @@ class STrackCutStudy {
     TH2D *hTrkVarVsPtReco[NType][NTrkVar];
     TH2D *hTrkVarVsPtTrue[NType][NTrkVar];
     TH2D *hTrkVarVsPtFrac[NType][NTrkVar];
+    TH2D *hTrkVarVsMult[NType][NTrkVar];
 
     // physics-variable histograms
     TH1D *hPhysVar[NType][NPhysVar];
@@ -163,6 +329,7 @@ class STrackCutStudy {
     TH2D *hPhysVarVsPtReco[NType][NPhysVar];
     TH2D *hPhysVarVsPtTrue[NType][NPhysVar];
     TH2D *hPhysVarVsPtFrac[NType][NPhysVar];
+    TH2D *hPhysVarVsMult[NType][NPhysVar];
 
     // text parameters
     Ssiz_t           nTxtEO;
@@ -179,6 +346,37 @@ class STrackCutStudy {
     Bool_t   doAvgClustCalc;
     Double_t normalPtFracMin;
     Double_t normalPtFracMax;
+    Bool_t   doFamFill[NPlotFam];
+
+    // event grouping: entries of each event are contiguous in '*EvtEntries',
+    // event i spans ['*EvtStarts[i]', '*EvtStarts[i + 1]')
+    Bool_t           doEventGroups;
+    Double_t         evtMult;  // of current entry's event (< 0 if unknown)
+    vector<UInt_t>   eoEntryMult;
+    vector<Long64_t> puEvtEntries;
+    vector<Long64_t> puEvtStarts;
+
+    // duplicates share a truth match (event, seed, gtrackID) with another
+    // track, ghosts have a truth purity (nfromtruth / nhits) below 'ghostPurityMin'
+    Bool_t         doDupGhost;
+    Double_t       ghostPurityMin;
+    vector<UInt_t> eoEntryDupMult;
+    TH1D          *hDupMult;
+
+    // efficiency and fake rate vs. pt, eta, phi, and nTPC [before, after cuts]
+    TString      sEffVars[NEffVar];
+    TString      sCutLevels[NCutLevel];
+    TEfficiency *eTrkEff[NCutLevel][NEffVar];
+    TEfficiency *eTrkFake[NCutLevel][NEffVar];
+
+    // paired differences of matched particles [(with pileup - embed only), (candidate - baseline)]
+    Bool_t    doPairing;
+    Long64_t  nPaired[NPairMode];
+    TString   sPairModes[NPairMode];
+    TH1D     *hPairTrkDiff[NPairMode][NTrkVar];
+    TH1D     *hPairPhysDiff[NPairMode][NPhysVar];
+    TH2D     *hPairTrkDiffVsPtTrue[NPairMode][NTrkVar];
+    TH2D     *hPairPhysDiffVsPtTrue[NPairMode][NPhysVar];
 
     // track cuts
     Bool_t                   doPrimaryCut;
@@ -290,6 +488,10 @@ class STrackCutStudy {
     Float_t nclusmaps;
     Float_t nclusmms;
 
+    // embed-only cluster summary leaves (friend of embed-only tuple)
+    Float_t cs_nclust;
+    Float_t cs_avgclustsize;
+
     // with-pileup leaves
     Float_t pu_event;
     Float_t pu_seed;
@@ -397,13 +599,43 @@ class STrackCutStudy {
     void InitFiles();
     void InitTuples();
     void SaveHists();
+    void WriteTypeHists(const Int_t type, TDirectory *dOut, const UInt_t nRebin=1);
+    void WriteHist(TH1 *hist, TDirectory *dOut, const UInt_t nRebin=1);
+    void SaveEfficiencies();
+    void SavePairedHists();
+    TString GetPyramidDir(const Int_t type, const UInt_t nRebin);
+    void InitPlotFiles();
+    void LoadVarHists(const Ssiz_t nToDraw, const Int_t typesToDraw[], const Int_t iVar, const Bool_t isTrkVar);
+    void ReleaseVarHists(const Ssiz_t nToDraw, const Int_t typesToDraw[], const Int_t iVar, const Bool_t isTrkVar);
+    TH1* ReadHist(TDirectory *dIn, const TString sHist);
+    void InitPlotCache();
+    void ClosePlotCache();
+    void InitCheckpoint();
+    Bool_t CheckCheckpoint();
+    void UpdateCheckpoint(const Bool_t doAllTypes);
+    void CloseCheckpoint();
+    void WriteTypeCheckpoint(const Int_t type);
+    void GetTypeHists(const Int_t type, vector<TH1*> &hists);
+    static void CatchTermSignal(int signal);
 
     // analysis methods [*.ana.h]
     Bool_t ApplyCuts(const Bool_t isPrimary, const UInt_t trkNMVtx, const UInt_t trkNTpc, const Double_t trkVz, const Double_t trkDcaXY, const Double_t trkDcaZ, const Double_t trkQuality);
     Bool_t DoClusterCalculation();
+    void GetTrackClusters(const Float_t trkEvent, const Float_t trkSeed, const Float_t trkID, Double_t &nClust, Double_t &avgSize);
+    void BuildEventIndex(TNtuple *tuple, Float_t &evtLeaf, Float_t &seedLeaf, vector<Long64_t> &entries, vector<Long64_t> &starts);
+    Long64_t ProcessPileupEntry(const Long64_t iEntry, const Long64_t iProg, const Long64_t nEntries);
+    void CalculateEmbedVars(const Double_t nClust, const Double_t avgClust, Double_t recoTrkVars[], Double_t trueTrkVars[], Double_t recoPhysVars[], Double_t truePhysVars[]);
+    void ProcessCandidate(const Long64_t iOffset, const Long64_t iStart, const Bool_t doDiffs);
+    void FindDuplicates(TNtuple *tuple, Float_t &evtLeaf, Float_t &seedLeaf, Float_t &gtrkLeaf, vector<UInt_t> &dupMult);
+    void BuildTruthIndex();
+    void MatchTrackToTruth(const Double_t recoEffVars[], const Double_t purity, const Bool_t isGoodTrk);
+    void FillEfficiencies();
+    void AddPairedTrack(const Float_t trkEvent, const Float_t trkSeed, const Float_t trkGID, const Double_t recoTrkVars[], const Double_t recoPhysVars[]);
+    void FillPairedHists(const Int_t mode, const Float_t trkEvent, const Float_t trkSeed, const Float_t trkGID, const Double_t recoTrkVars[], const Double_t recoPhysVars[], const Double_t ptTrue);
 
     // histogram methods [*.hist.h]
     void InitHists();
+    void InitEfficiencies();
     void NormalizeHists();
     void SetHistStyles();
     void FillTrackHistograms(const Int_t type, const Double_t recoTrkVars[], const Double_t trueTrkVars[], const Double_t recoPhysVars[], const Double_t truePhysVars[]);
@@ -411,7 +643,16 @@ class STrackCutStudy {
 
     // plot methods [*.plot.h]
     void MakeCutText();
+    void MakePlots();
+    void MakePlotsInParallel(const Bool_t isGroupOn[], const Int_t groupTypes[][NGroupType], const TString sGroupDirs[], const TString sGroupLabels[]);
     void ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDraw[], const TString sDirToSaveTo, const TString sPlotLabel);
+    void SaveCanvas(TCanvas *canvas, const TString sDirToSaveTo);
+    void DrawReducedHist(TH2D *hist, const TString sOption);
+    Int_t GetRebinFactor(const Int_t nBins, const Int_t nMaxBins);
+    TString GetPlotHash(const Ssiz_t nToDraw, const Int_t typesToDraw[], const Int_t iVar, const Bool_t isTrkVar, const TString sPlotLabel, const TString sPlotStyle);
+    Bool_t CopyPreviousPlots(const TString sDirToSaveTo, const TString sVar, const TString sPlotLabel, const TString sHash);
+    void MakeCandidateRatios();
+    void WritePlotIndex(const Bool_t isGroupOn[], const TString sGroupDirs[], const TString sGroupLabels[]);
 
 };  // end STrackCutStudy definition
 
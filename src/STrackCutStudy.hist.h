@@ -33,6 +33,8 @@ void STrackCutStudy::InitHists() {
   const UInt_t  nXYVtxBins(1000);
   const UInt_t  nZVtxBins(1200);
   const UInt_t  nDVtxBins(2400);
+  const UInt_t  nMultBins(100);
+  const UInt_t  nDupBins(10);
   const Float_t rNHitBins[NRange]   = {0,     100};
   const Float_t rQualBins[NRange]   = {0.,    20.};
   const Float_t rDcaBins[NRange]    = {-100., 100.};
@@ -46,6 +48,8 @@ void STrackCutStudy::InitHists() {
   const Float_t rXYVtxBins[NRange]  = {-1.,   1.};
   const Float_t rZVtxBins[NRange]   = {-300., 300.};
   const Float_t rDVtxBins[NRange]   = {-600., 600.};
+  const Float_t rMultBins[NRange]   = {0.,    10000.};
+  const Float_t rDupBins[NRange]    = {0.5,   10.5};
 
   // for track-variable histogram names
   TString sTrkVar[NType][NTrkVar];
@@ -57,6 +61,7 @@ void STrackCutStudy::InitHists() {
   TString sTrkVarVsPtReco[NType][NTrkVar];
   TString sTrkVarVsPtTrue[NType][NTrkVar];
   TString sTrkVarVsPtFrac[NType][NTrkVar];
+  TString sTrkVarVsMult[NType][NTrkVar];
 
   // for physics-variable histogram names
   TString sPhysVar[NType][NPhysVar];
@@ -68,6 +73,7 @@ void STrackCutStudy::InitHists() {
   TString sPhysVarVsPtReco[NType][NPhysVar];
   TString sPhysVarVsPtTrue[NType][NPhysVar];
   TString sPhysVarVsPtFrac[NType][NPhysVar];
+  TString sPhysVarVsMult[NType][NPhysVar];
 
   // form histogram names
   const TString sDiffSuffix("Diff");
@@ -78,6 +84,7 @@ void STrackCutStudy::InitHists() {
   const TString sVsPtRecoSuffix("VsPtReco");
   const TString sVsPtTrueSuffix("VsPtTrue");
   const TString sVsPtFracSuffix("VsPtFrac");
+  const TString sVsMultSuffix("VsMult");
 
   // construct variable prefixes
   TString sTrkVarName[NTrkVar];
@@ -109,6 +116,7 @@ void STrackCutStudy::InitHists() {
       sTrkVarVsPtReco[iType][iTrkVar] = sTrkVarName[iTrkVar].Data();
       sTrkVarVsPtTrue[iType][iTrkVar] = sTrkVarName[iTrkVar].Data();
       sTrkVarVsPtFrac[iType][iTrkVar] = sTrkVarName[iTrkVar].Data();
+      sTrkVarVsMult[iType][iTrkVar]   = sTrkVarName[iTrkVar].Data();
       sTrkVarDiff[iType][iTrkVar].Append(sDiffSuffix.Data());
       sTrkVarFrac[iType][iTrkVar].Append(sFracSuffix.Data());
       sTrkVarVsNTpc[iType][iTrkVar].Append(sVsNTpcSuffix.Data());
@@ -117,6 +125,7 @@ void STrackCutStudy::InitHists() {
       sTrkVarVsPtReco[iType][iTrkVar].Append(sVsPtRecoSuffix.Data());
       sTrkVarVsPtTrue[iType][iTrkVar].Append(sVsPtTrueSuffix.Data());
       sTrkVarVsPtFrac[iType][iTrkVar].Append(sVsPtFracSuffix.Data());
+      sTrkVarVsMult[iType][iTrkVar].Append(sVsMultSuffix.Data());
       sTrkVar[iType][iTrkVar].Append(sTypeSuffix[iType].Data());
       sTrkVarDiff[iType][iTrkVar].Append(sTypeSuffix[iType].Data());
       sTrkVarFrac[iType][iTrkVar].Append(sTypeSuffix[iType].Data());
@@ -126,6 +135,7 @@ void STrackCutStudy::InitHists() {
       sTrkVarVsPtReco[iType][iTrkVar].Append(sTypeSuffix[iType].Data());
       sTrkVarVsPtTrue[iType][iTrkVar].Append(sTypeSuffix[iType].Data());
       sTrkVarVsPtFrac[iType][iTrkVar].Append(sTypeSuffix[iType].Data());
+      sTrkVarVsMult[iType][iTrkVar].Append(sTypeSuffix[iType].Data());
     }
     for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
       sPhysVar[iType][iPhysVar]         = sPhysVarName[iPhysVar].Data();
@@ -137,6 +147,7 @@ void STrackCutStudy::InitHists() {
       sPhysVarVsPtReco[iType][iPhysVar] = sPhysVarName[iPhysVar].Data();
       sPhysVarVsPtTrue[iType][iPhysVar] = sPhysVarName[iPhysVar].Data();
       sPhysVarVsPtFrac[iType][iPhysVar] = sPhysVarName[iPhysVar].Data();
+      sPhysVarVsMult[iType][iPhysVar]   = sPhysVarName[iPhysVar].Data();
       sPhysVarDiff[iType][iPhysVar].Append(sDiffSuffix.Data());
       sPhysVarFrac[iType][iPhysVar].Append(sFracSuffix.Data());
       sPhysVarVsNTpc[iType][iPhysVar].Append(sVsNTpcSuffix.Data());
@@ -145,6 +156,7 @@ void STrackCutStudy::InitHists() {
       sPhysVarVsPtReco[iType][iPhysVar].Append(sVsPtRecoSuffix.Data());
       sPhysVarVsPtTrue[iType][iPhysVar].Append(sVsPtTrueSuffix.Data());
       sPhysVarVsPtFrac[iType][iPhysVar].Append(sVsPtFracSuffix.Data());
+      sPhysVarVsMult[iType][iPhysVar].Append(sVsMultSuffix.Data());
       sPhysVar[iType][iPhysVar].Append(sTypeSuffix[iType].Data());
       sPhysVarDiff[iType][iPhysVar].Append(sTypeSuffix[iType].Data());
       sPhysVarFrac[iType][iPhysVar].Append(sTypeSuffix[iType].Data());
@@ -154,6 +166,7 @@ void STrackCutStudy::InitHists() {
       sPhysVarVsPtReco[iType][iPhysVar].Append(sTypeSuffix[iType].Data());
       sPhysVarVsPtTrue[iType][iPhysVar].Append(sTypeSuffix[iType].Data());
       sPhysVarVsPtFrac[iType][iPhysVar].Append(sTypeSuffix[iType].Data());
+      sPhysVarVsMult[iType][iPhysVar].Append(sTypeSuffix[iType].Data());
     }
   }  // end type loop
 
@@ -203,6 +216,8 @@ void STrackCutStudy::InitHists() {
       if (isBeforeCuts[iType] && !doBeforeCuts) continue;
       if (isPileup[iType]     && !doPileup)     continue;
     }
+    if (isCandidate[iType] && !doCandidate) continue;
+    if (isDupGhost[iType]  && !doDupGhost)  continue;
 
     for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
       hTrkVar[iType][iTrkVar]         = new TH1D(sTrkVar[iType][iTrkVar].Data(),         "", nTrkBins[iTrkVar],     rTrkBins[iTrkVar][0],     rTrkBins[iTrkVar][1]);
@@ -223,6 +238,14 @@ void STrackCutStudy::InitHists() {
       hTrkVarVsPtReco[iType][iTrkVar] -> Sumw2();
       hTrkVarVsPtTrue[iType][iTrkVar] -> Sumw2();
       hTrkVarVsPtFrac[iType][iTrkVar] -> Sumw2();
+
+      // event multiplicity is only known when entries are grouped by event
+      if (doEventGroups) {
+        hTrkVarVsMult[iType][iTrkVar] = new TH2D(sTrkVarVsMult[iType][iTrkVar].Data(), "", nMultBins, rMultBins[0], rMultBins[1], nTrkBins[iTrkVar], rTrkBins[iTrkVar][0], rTrkBins[iTrkVar][1]);
+        hTrkVarVsMult[iType][iTrkVar] -> Sumw2();
+      } else {
+        hTrkVarVsMult[iType][iTrkVar] = NULL;
+      }
     }
     for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
       hPhysVar[iType][iPhysVar]         = new TH1D(sPhysVar[iType][iPhysVar].Data(),         "", nPhysBins[iPhysVar],     rPhysBins[iPhysVar][0],     rPhysBins[iPhysVar][1]);
@@ -243,6 +266,44 @@ void STrackCutStudy::InitHists() {
       hPhysVarVsPtReco[iType][iPhysVar] -> Sumw2();
       hPhysVarVsPtTrue[iType][iPhysVar] -> Sumw2();
       hPhysVarVsPtFrac[iType][iPhysVar] -> Sumw2();
+
+      // event multiplicity is only known when entries are grouped by event
+      if (doEventGroups) {
+        hPhysVarVsMult[iType][iPhysVar] = new TH2D(sPhysVarVsMult[iType][iPhysVar].Data(), "", nMultBins, rMultBins[0], rMultBins[1], nPhysBins[iPhysVar], rPhysBins[iPhysVar][0], rPhysBins[iPhysVar][1]);
+        hPhysVarVsMult[iType][iPhysVar] -> Sumw2();
+      } else {
+        hPhysVarVsMult[iType][iPhysVar] = NULL;
+      }
+    }
+  }
+
+  // no. of tracks per truth-matched particle
+  if (doDupGhost) {
+    hDupMult = new TH1D("hDupMult", "", nDupBins, rDupBins[0], rDupBins[1]);
+    hDupMult -> Sumw2();
+    hDupMult -> GetXaxis() -> SetTitle("N_{trk} sharing truth match");
+    hDupMult -> GetYaxis() -> SetTitle("N_{particle}");
+  }
+
+  // paired differences of matched particles
+  const Bool_t isPairOn[NPairMode] = {doPairing, doCandidate};
+  for (Ssiz_t iMode = 0; iMode < NPairMode; iMode++) {
+    if (!isPairOn[iMode]) continue;
+
+    const TString sModeSuffix = "_" + sPairModes[iMode];
+    for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+      const TString sPair = "hPair" + sTrkVars[iTrkVar] + "Diff";
+      hPairTrkDiff[iMode][iTrkVar]         = new TH1D((sPair + sModeSuffix).Data(),              "", nTrkDiffBins[iTrkVar], rTrkDiffBins[iTrkVar][0], rTrkDiffBins[iTrkVar][1]);
+      hPairTrkDiffVsPtTrue[iMode][iTrkVar] = new TH2D((sPair + "VsPtTrue" + sModeSuffix).Data(), "", nPtBins, rPtBins[0], rPtBins[1], nTrkDiffBins[iTrkVar], rTrkDiffBins[iTrkVar][0], rTrkDiffBins[iTrkVar][1]);
+      hPairTrkDiff[iMode][iTrkVar]         -> Sumw2();
+      hPairTrkDiffVsPtTrue[iMode][iTrkVar] -> Sumw2();
+    }
+    for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+      const TString sPair = "hPair" + sPhysVars[iPhysVar] + "Diff";
+      hPairPhysDiff[iMode][iPhysVar]         = new TH1D((sPair + sModeSuffix).Data(),              "", nPhysDiffBins[iPhysVar], rPhysDiffBins[iPhysVar][0], rPhysDiffBins[iPhysVar][1]);
+      hPairPhysDiffVsPtTrue[iMode][iPhysVar] = new TH2D((sPair + "VsPtTrue" + sModeSuffix).Data(), "", nPtBins, rPtBins[0], rPtBins[1], nPhysDiffBins[iPhysVar], rPhysDiffBins[iPhysVar][0], rPhysDiffBins[iPhysVar][1]);
+      hPairPhysDiff[iMode][iPhysVar]         -> Sumw2();
+      hPairPhysDiffVsPtTrue[iMode][iPhysVar] -> Sumw2();
     }
   }
   cout << "      Initialized output histograms." << endl;
@@ -252,6 +313,33 @@ void STrackCutStudy::InitHists() {
 
 
 
+void STrackCutStudy::InitEfficiencies() {
+
+  // efficiency binning [pt, eta, phi, nTPC]
+  const UInt_t  nEffBins[NEffVar]         = {100, 400, 60, 100};
+  const Float_t rEffBins[NEffVar][NRange] = {{0., 100.}, {-2., 2.}, {-3.15, 3.15}, {0., 100.}};
+
+  // axis titles
+  const TString sEffTitles[NEffVar]  = {"p_{T}^{true} [GeV/c]", "#eta^{true}", "#varphi^{true}", "N_{hit}^{tpc,true}"};
+  const TString sFakeTitles[NEffVar] = {"p_{T}^{reco} [GeV/c]", "#eta^{reco}", "#varphi^{reco}", "N_{hit}^{tpc,reco}"};
+
+  for (Ssiz_t iLevel = 0; iLevel < NCutLevel; iLevel++) {
+    for (Ssiz_t iEffVar = 0; iEffVar < NEffVar; iEffVar++) {
+      const TString sEffName  = "eEff"  + sEffVars[iEffVar] + "_" + sCutLevels[iLevel];
+      const TString sFakeName = "eFake" + sEffVars[iEffVar] + "_" + sCutLevels[iLevel];
+      const TString sEffAxes  = ";" + sEffTitles[iEffVar]  + ";efficiency";
+      const TString sFakeAxes = ";" + sFakeTitles[iEffVar] + ";fake rate";
+      eTrkEff[iLevel][iEffVar]  = new TEfficiency(sEffName.Data(),  sEffAxes.Data(),  nEffBins[iEffVar], rEffBins[iEffVar][0], rEffBins[iEffVar][1]);
+      eTrkFake[iLevel][iEffVar] = new TEfficiency(sFakeName.Data(), sFakeAxes.Data(), nEffBins[iEffVar], rEffBins[iEffVar][0], rEffBins[iEffVar][1]);
+    }
+  }
+  cout << "      Initialized efficiencies." << endl;
+  return;
+
+}  // end 'InitEfficiencies()'
+
+
+
 void STrackCutStudy::NormalizeHists() {
 
   for (int iType = 0; iType < NType; iType++) {
@@ -261,6 +349,8 @@ void STrackCutStudy::NormalizeHists() {
       if (isBeforeCuts[iType] && !doBeforeCuts) continue;
       if (isPileup[iType]     && !doPileup)     continue;
     }
+    if (isCandidate[iType] && !doCandidate) continue;
+    if (isDupGhost[iType]  && !doDupGhost)  continue;
 
     for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
       const Double_t intTrkVar         = hTrkVar[iType][iTrkVar]         -> Integral();
@@ -272,6 +362,7 @@ void STrackCutStudy::NormalizeHists() {
       const Double_t intTrkVarVsPtReco = hTrkVarVsPtReco[iType][iTrkVar] -> Integral();
       const Double_t intTrkVarVsPtTrue = hTrkVarVsPtTrue[iType][iTrkVar] -> Integral();
       const Double_t intTrkVarVsPtFrac = hTrkVarVsPtFrac[iType][iTrkVar] -> Integral();
+      const Double_t intTrkVarVsMult   = hTrkVarVsMult[iType][iTrkVar]   ? hTrkVarVsMult[iType][iTrkVar] -> Integral() : 0.;
       if (intTrkVar         > 0.) hTrkVar[iType][iTrkVar]         -> Scale(1. / intTrkVar);
       if (intTrkVarDiff     > 0.) hTrkVarDiff[iType][iTrkVar]     -> Scale(1. / intTrkVarDiff);
       if (intTrkVarFrac     > 0.) hTrkVarFrac[iType][iTrkVar]     -> Scale(1. / intTrkVarFrac);
@@ -281,6 +372,7 @@ void STrackCutStudy::NormalizeHists() {
       if (intTrkVarVsPtReco > 0.) hTrkVarVsPtReco[iType][iTrkVar] -> Scale(1. / intTrkVarVsPtReco);
       if (intTrkVarVsPtTrue > 0.) hTrkVarVsPtTrue[iType][iTrkVar] -> Scale(1. / intTrkVarVsPtTrue);
       if (intTrkVarVsPtFrac > 0.) hTrkVarVsPtFrac[iType][iTrkVar] -> Scale(1. / intTrkVarVsPtFrac);
+      if (intTrkVarVsMult   > 0.) hTrkVarVsMult[iType][iTrkVar]   -> Scale(1. / intTrkVarVsMult);
     }
     for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
       const Double_t intPhysVar         = hPhysVar[iType][iPhysVar]         -> Integral();
@@ -292,6 +384,7 @@ void STrackCutStudy::NormalizeHists() {
       const Double_t intPhysVarVsPtReco = hPhysVarVsPtReco[iType][iPhysVar] -> Integral();
       const Double_t intPhysVarVsPtTrue = hPhysVarVsPtTrue[iType][iPhysVar] -> Integral();
       const Double_t intPhysVarVsPtFrac = hPhysVarVsPtFrac[iType][iPhysVar] -> Integral();
+      const Double_t intPhysVarVsMult   = hPhysVarVsMult[iType][iPhysVar]   ? hPhysVarVsMult[iType][iPhysVar] -> Integral() : 0.;
       if (intPhysVar         > 0.) hPhysVar[iType][iPhysVar]         -> Scale(1. / intPhysVar);
       if (intPhysVarDiff     > 0.) hPhysVarDiff[iType][iPhysVar]     -> Scale(1. / intPhysVarDiff);
       if (intPhysVarFrac     > 0.) hPhysVarFrac[iType][iPhysVar]     -> Scale(1. / intPhysVarFrac);
@@ -301,6 +394,7 @@ void STrackCutStudy::NormalizeHists() {
       if (intPhysVarVsPtReco > 0.) hPhysVarVsPtReco[iType][iPhysVar] -> Scale(1. / intPhysVarVsPtReco);
       if (intPhysVarVsPtTrue > 0.) hPhysVarVsPtTrue[iType][iPhysVar] -> Scale(1. / intPhysVarVsPtTrue);
       if (intPhysVarVsPtFrac > 0.) hPhysVarVsPtFrac[iType][iPhysVar] -> Scale(1. / intPhysVarVsPtFrac);
+      if (intPhysVarVsMult   > 0.) hPhysVarVsMult[iType][iPhysVar]   -> Scale(1. / intPhysVarVsMult);
     }
   }
   cout << "      Normalized histograms." << endl;
@@ -350,6 +444,7 @@ void STrackCutStudy::SetHistStyles() {
   const TString sDeltaPt("#Deltap_{T}^{trk} / p_{T}^{trk}");
   const TString sTrkNClust("N_{clust}");
   const TString sTrkAvgClust("<cluster size>");
+  const TString sEvtMult("N_{trk}^{evt}");
 
   // difference axis titles
   const TString sDiffVx("v_{x}^{reco} - v_{x}^{truth}");
@@ -416,8 +511,14 @@ void STrackCutStudy::SetHistStyles() {
       if (isBeforeCuts[iType] && !doBeforeCuts) continue;
       if (isPileup[iType]     && !doPileup)     continue;
     }
+    if (isCandidate[iType] && !doCandidate) continue;
+    if (isDupGhost[iType]  && !doDupGhost)  continue;
 
     for (Int_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+
+      // skip variables not loaded (plot-only mode)
+      if (!hTrkVar[iType][iTrkVar]) continue;
+
       hTrkVar[iType][iTrkVar]         -> SetMarkerColor(fTypeCol[iType]);
       hTrkVar[iType][iTrkVar]         -> SetMarkerStyle(fTypeMar[iType]);
       hTrkVar[iType][iTrkVar]         -> SetLineColor(fTypeCol[iType]);
@@ -553,8 +654,30 @@ void STrackCutStudy::SetHistStyles() {
       hTrkVarVsPtFrac[iType][iTrkVar] -> GetZaxis() -> SetTitle(sCountToUse.Data());
       hTrkVarVsPtFrac[iType][iTrkVar] -> GetZaxis() -> SetTitleFont(FTxt);
       hTrkVarVsPtFrac[iType][iTrkVar] -> GetZaxis() -> SetTitleOffset(fOffZ);
+      if (hTrkVarVsMult[iType][iTrkVar]) {
+        hTrkVarVsMult[iType][iTrkVar] -> SetMarkerColor(fTypeCol[iType]);
+        hTrkVarVsMult[iType][iTrkVar] -> SetMarkerStyle(fMar2D);
+        hTrkVarVsMult[iType][iTrkVar] -> SetLineColor(fTypeCol[iType]);
+        hTrkVarVsMult[iType][iTrkVar] -> SetLineStyle(fLin);
+        hTrkVarVsMult[iType][iTrkVar] -> SetFillColor(fTypeCol[iType]);
+        hTrkVarVsMult[iType][iTrkVar] -> SetFillStyle(fFil);
+        hTrkVarVsMult[iType][iTrkVar] -> SetTitleFont(FTxt);
+        hTrkVarVsMult[iType][iTrkVar] -> GetXaxis() -> SetTitle(sEvtMult.Data());
+        hTrkVarVsMult[iType][iTrkVar] -> GetXaxis() -> SetTitleFont(FTxt);
+        hTrkVarVsMult[iType][iTrkVar] -> GetXaxis() -> SetTitleOffset(fOffX);
+        hTrkVarVsMult[iType][iTrkVar] -> GetYaxis() -> SetTitle(sTrkTitles[iTrkVar].Data());
+        hTrkVarVsMult[iType][iTrkVar] -> GetYaxis() -> SetTitleFont(FTxt);
+        hTrkVarVsMult[iType][iTrkVar] -> GetYaxis() -> SetTitleOffset(fOffY);
+        hTrkVarVsMult[iType][iTrkVar] -> GetZaxis() -> SetTitle(sCountToUse.Data());
+        hTrkVarVsMult[iType][iTrkVar] -> GetZaxis() -> SetTitleFont(FTxt);
+        hTrkVarVsMult[iType][iTrkVar] -> GetZaxis() -> SetTitleOffset(fOffZ);
+      }
     }
     for (Int_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+
+      // skip variables not loaded (plot-only mode)
+      if (!hPhysVar[iType][iPhysVar]) continue;
+
       hPhysVar[iType][iPhysVar]         -> SetMarkerColor(fTypeCol[iType]);
       hPhysVar[iType][iPhysVar]         -> SetMarkerStyle(fTypeMar[iType]);
       hPhysVar[iType][iPhysVar]         -> SetLineColor(fTypeCol[iType]);
@@ -690,6 +813,24 @@ void STrackCutStudy::SetHistStyles() {
       hPhysVarVsPtFrac[iType][iPhysVar] -> GetZaxis() -> SetTitle(sCountToUse.Data());
       hPhysVarVsPtFrac[iType][iPhysVar] -> GetZaxis() -> SetTitleFont(FTxt);
       hPhysVarVsPtFrac[iType][iPhysVar] -> GetZaxis() -> SetTitleOffset(fOffZ);
+      if (hPhysVarVsMult[iType][iPhysVar]) {
+        hPhysVarVsMult[iType][iPhysVar] -> SetMarkerColor(fTypeCol[iType]);
+        hPhysVarVsMult[iType][iPhysVar] -> SetMarkerStyle(fMar2D);
+        hPhysVarVsMult[iType][iPhysVar] -> SetLineColor(fTypeCol[iType]);
+        hPhysVarVsMult[iType][iPhysVar] -> SetLineStyle(fLin);
+        hPhysVarVsMult[iType][iPhysVar] -> SetFillColor(fTypeCol[iType]);
+        hPhysVarVsMult[iType][iPhysVar] -> SetFillStyle(fFil);
+        hPhysVarVsMult[iType][iPhysVar] -> SetTitleFont(FTxt);
+        hPhysVarVsMult[iType][iPhysVar] -> GetXaxis() -> SetTitle(sEvtMult.Data());
+        hPhysVarVsMult[iType][iPhysVar] -> GetXaxis() -> SetTitleFont(FTxt);
+        hPhysVarVsMult[iType][iPhysVar] -> GetXaxis() -> SetTitleOffset(fOffX);
+        hPhysVarVsMult[iType][iPhysVar] -> GetYaxis() -> SetTitle(sPhysTitles[iPhysVar].Data());
+        hPhysVarVsMult[iType][iPhysVar] -> GetYaxis() -> SetTitleFont(FTxt);
+        hPhysVarVsMult[iType][iPhysVar] -> GetYaxis() -> SetTitleOffset(fOffY);
+        hPhysVarVsMult[iType][iPhysVar] -> GetZaxis() -> SetTitle(sCountToUse.Data());
+        hPhysVarVsMult[iType][iPhysVar] -> GetZaxis() -> SetTitleFont(FTxt);
+        hPhysVarVsMult[iType][iPhysVar] -> GetZaxis() -> SetTitleOffset(fOffZ);
+      }
     }
   }
   cout << "      Set histogram styles." << endl;
@@ -707,6 +848,10 @@ void STrackCutStudy::FillTrackHistograms(const Int_t type, const Double_t recoTr
     assert(!isTruth[type]);
   }
 
+  // skip entries already in a restored checkpoint
+  if (iCurrent < nDoneType[type]) return;
+  isTypeDirty[type] = true;
+
   // grab 2d x-axes
   const auto nTpc   = recoTrkVars[TRKVAR::NTPC];
   const auto dcaXY  = recoTrkVars[TRKVAR::DCAXY];
@@ -715,6 +860,9 @@ void STrackCutStudy::FillTrackHistograms(const Int_t type, const Double_t recoTr
   const auto ptTrue = truePhysVars[PHYSVAR::PT];
   const auto ptFrac = ptRec / ptTrue;
 
+  // multiplicity hists only exist (and evtMult is only known) with event grouping
+  const Bool_t doMultFill = (doFamFill[PLOTFAM::FAM_VSMULT] && doEventGroups && (evtMult >= 0.));
+
   // fill track variable hists
   for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
 
@@ -723,15 +871,16 @@ void STrackCutStudy::FillTrackHistograms(const Int_t type, const Double_t recoTr
     const auto trkVarFrac = recoTrkVars[iTrkVar] / trueTrkVars[iTrkVar];
 
     // fill hists
-    hTrkVar[type][iTrkVar]         -> Fill(recoTrkVars[iTrkVar]);
-    hTrkVarDiff[type][iTrkVar]     -> Fill(trkVarDiff);
-    hTrkVarFrac[type][iTrkVar]     -> Fill(trkVarFrac);
-    hTrkVarVsNTpc[type][iTrkVar]   -> Fill(nTpc,   recoTrkVars[iTrkVar]);
-    hTrkVarVsDcaXY[type][iTrkVar]  -> Fill(dcaXY,  recoTrkVars[iTrkVar]);
-    hTrkVarVsDcaZ[type][iTrkVar]   -> Fill(dcaZ,   recoTrkVars[iTrkVar]);
-    hTrkVarVsPtReco[type][iTrkVar] -> Fill(ptRec,  recoTrkVars[iTrkVar]);
-    hTrkVarVsPtTrue[type][iTrkVar] -> Fill(ptTrue, recoTrkVars[iTrkVar]);
-    hTrkVarVsPtFrac[type][iTrkVar] -> Fill(ptFrac, recoTrkVars[iTrkVar]); 
+    if (doFamFill[PLOTFAM::FAM_SPEC])     hTrkVar[type][iTrkVar]         -> Fill(recoTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_DIFF])     hTrkVarDiff[type][iTrkVar]     -> Fill(trkVarDiff);
+    if (doFamFill[PLOTFAM::FAM_FRAC])     hTrkVarFrac[type][iTrkVar]     -> Fill(trkVarFrac);
+    if (doFamFill[PLOTFAM::FAM_VSNTPC])   hTrkVarVsNTpc[type][iTrkVar]   -> Fill(nTpc,   recoTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSDCAXY])  hTrkVarVsDcaXY[type][iTrkVar]  -> Fill(dcaXY,  recoTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSDCAZ])   hTrkVarVsDcaZ[type][iTrkVar]   -> Fill(dcaZ,   recoTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTRECO]) hTrkVarVsPtReco[type][iTrkVar] -> Fill(ptRec,  recoTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTTRUE]) hTrkVarVsPtTrue[type][iTrkVar] -> Fill(ptTrue, recoTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTFRAC]) hTrkVarVsPtFrac[type][iTrkVar] -> Fill(ptFrac, recoTrkVars[iTrkVar]); 
+    if (doMultFill)                       hTrkVarVsMult[type][iTrkVar]   -> Fill(evtMult, recoTrkVars[iTrkVar]);
   }
 
   // fill track variable hists
@@ -742,15 +891,16 @@ void STrackCutStudy::FillTrackHistograms(const Int_t type, const Double_t recoTr
     const auto trkVarFrac = recoPhysVars[iPhysVar] / truePhysVars[iPhysVar];
 
     // fill hists
-    hPhysVar[type][iPhysVar]         -> Fill(recoPhysVars[iPhysVar]);
-    hPhysVarDiff[type][iPhysVar]     -> Fill(trkVarDiff);
-    hPhysVarFrac[type][iPhysVar]     -> Fill(trkVarFrac);
-    hPhysVarVsNTpc[type][iPhysVar]   -> Fill(nTpc,   recoPhysVars[iPhysVar]);
-    hPhysVarVsDcaXY[type][iPhysVar]  -> Fill(dcaXY,  recoPhysVars[iPhysVar]);
-    hPhysVarVsDcaZ[type][iPhysVar]   -> Fill(dcaZ,   recoPhysVars[iPhysVar]);
-    hPhysVarVsPtReco[type][iPhysVar] -> Fill(ptRec,  recoPhysVars[iPhysVar]);
-    hPhysVarVsPtTrue[type][iPhysVar] -> Fill(ptTrue, recoPhysVars[iPhysVar]);
-    hPhysVarVsPtFrac[type][iPhysVar] -> Fill(ptFrac, recoPhysVars[iPhysVar]); 
+    if (doFamFill[PLOTFAM::FAM_SPEC])     hPhysVar[type][iPhysVar]         -> Fill(recoPhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_DIFF])     hPhysVarDiff[type][iPhysVar]     -> Fill(trkVarDiff);
+    if (doFamFill[PLOTFAM::FAM_FRAC])     hPhysVarFrac[type][iPhysVar]     -> Fill(trkVarFrac);
+    if (doFamFill[PLOTFAM::FAM_VSNTPC])   hPhysVarVsNTpc[type][iPhysVar]   -> Fill(nTpc,   recoPhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSDCAXY])  hPhysVarVsDcaXY[type][iPhysVar]  -> Fill(dcaXY,  recoPhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSDCAZ])   hPhysVarVsDcaZ[type][iPhysVar]   -> Fill(dcaZ,   recoPhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTRECO]) hPhysVarVsPtReco[type][iPhysVar] -> Fill(ptRec,  recoPhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTTRUE]) hPhysVarVsPtTrue[type][iPhysVar] -> Fill(ptTrue, recoPhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTFRAC]) hPhysVarVsPtFrac[type][iPhysVar] -> Fill(ptFrac, recoPhysVars[iPhysVar]); 
+    if (doMultFill)                       hPhysVarVsMult[type][iPhysVar]   -> Fill(evtMult, recoPhysVars[iPhysVar]);
   }
   return;
 
@@ -766,6 +916,10 @@ void STrackCutStudy::FillTruthHistograms(const Int_t type, const Double_t recoTr
     assert(isTruth[type]);
   }
 
+  // skip entries already in a restored checkpoint
+  if (iCurrent < nDoneType[type]) return;
+  isTypeDirty[type] = true;
+
   // grab 2d x-axes
   const auto nTpc   = recoTrkVars[TRKVAR::NTPC];
   const auto dcaXY  = recoTrkVars[TRKVAR::DCAXY];
@@ -774,6 +928,9 @@ void STrackCutStudy::FillTruthHistograms(const Int_t type, const Double_t recoTr
   const auto ptTrue = truePhysVars[PHYSVAR::PT];
   const auto ptFrac = ptRec / ptTrue;
 
+  // multiplicity hists only exist (and evtMult is only known) with event grouping
+  const Bool_t doMultFill = (doFamFill[PLOTFAM::FAM_VSMULT] && doEventGroups && (evtMult >= 0.));
+
   // fill track variable hists
   for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
 
@@ -781,13 +938,14 @@ void STrackCutStudy::FillTruthHistograms(const Int_t type, const Double_t recoTr
     if (!trkVarHasTruVal[iTrkVar]) continue;
 
     // fill hists
-    hTrkVar[type][iTrkVar]         -> Fill(trueTrkVars[iTrkVar]);
-    hTrkVarVsNTpc[type][iTrkVar]   -> Fill(nTpc,   trueTrkVars[iTrkVar]);
-    hTrkVarVsDcaXY[type][iTrkVar]  -> Fill(dcaXY,  trueTrkVars[iTrkVar]);
-    hTrkVarVsDcaZ[type][iTrkVar]   -> Fill(dcaZ,   trueTrkVars[iTrkVar]);
-    hTrkVarVsPtReco[type][iTrkVar] -> Fill(ptRec,  trueTrkVars[iTrkVar]);
-    hTrkVarVsPtTrue[type][iTrkVar] -> Fill(ptTrue, trueTrkVars[iTrkVar]);
-    hTrkVarVsPtFrac[type][iTrkVar] -> Fill(ptFrac, trueTrkVars[iTrkVar]); 
+    if (doFamFill[PLOTFAM::FAM_SPEC])     hTrkVar[type][iTrkVar]         -> Fill(trueTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSNTPC])   hTrkVarVsNTpc[type][iTrkVar]   -> Fill(nTpc,   trueTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSDCAXY])  hTrkVarVsDcaXY[type][iTrkVar]  -> Fill(dcaXY,  trueTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSDCAZ])   hTrkVarVsDcaZ[type][iTrkVar]   -> Fill(dcaZ,   trueTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTRECO]) hTrkVarVsPtReco[type][iTrkVar] -> Fill(ptRec,  trueTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTTRUE]) hTrkVarVsPtTrue[type][iTrkVar] -> Fill(ptTrue, trueTrkVars[iTrkVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTFRAC]) hTrkVarVsPtFrac[type][iTrkVar] -> Fill(ptFrac, trueTrkVars[iTrkVar]); 
+    if (doMultFill)                       hTrkVarVsMult[type][iTrkVar]   -> Fill(evtMult, trueTrkVars[iTrkVar]);
   }
 
   // fill track variable hists
@@ -797,13 +955,14 @@ void STrackCutStudy::FillTruthHistograms(const Int_t type, const Double_t recoTr
     if (!physVarHasTruVal[iPhysVar]) continue;
 
     // fill hists
-    hPhysVar[type][iPhysVar]         -> Fill(truePhysVars[iPhysVar]);
-    hPhysVarVsNTpc[type][iPhysVar]   -> Fill(nTpc,   truePhysVars[iPhysVar]);
-    hPhysVarVsDcaXY[type][iPhysVar]  -> Fill(dcaXY,  truePhysVars[iPhysVar]);
-    hPhysVarVsDcaZ[type][iPhysVar]   -> Fill(dcaZ,   truePhysVars[iPhysVar]);
-    hPhysVarVsPtReco[type][iPhysVar] -> Fill(ptRec,  truePhysVars[iPhysVar]);
-    hPhysVarVsPtTrue[type][iPhysVar] -> Fill(ptTrue, truePhysVars[iPhysVar]);
-    hPhysVarVsPtFrac[type][iPhysVar] -> Fill(ptFrac, truePhysVars[iPhysVar]); 
+    if (doFamFill[PLOTFAM::FAM_SPEC])     hPhysVar[type][iPhysVar]         -> Fill(truePhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSNTPC])   hPhysVarVsNTpc[type][iPhysVar]   -> Fill(nTpc,   truePhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSDCAXY])  hPhysVarVsDcaXY[type][iPhysVar]  -> Fill(dcaXY,  truePhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSDCAZ])   hPhysVarVsDcaZ[type][iPhysVar]   -> Fill(dcaZ,   truePhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTRECO]) hPhysVarVsPtReco[type][iPhysVar] -> Fill(ptRec,  truePhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTTRUE]) hPhysVarVsPtTrue[type][iPhysVar] -> Fill(ptTrue, truePhysVars[iPhysVar]);
+    if (doFamFill[PLOTFAM::FAM_VSPTFRAC]) hPhysVarVsPtFrac[type][iPhysVar] -> Fill(ptFrac, truePhysVars[iPhysVar]); 
+    if (doMultFill)                       hPhysVarVsMult[type][iPhysVar]   -> Fill(evtMult, truePhysVars[iPhysVar]);
   }
   return;
 
@@ -68,6 +68,107 @@ void STrackCutStudy::SetInputTuples(const TString sEmbedOnlyTuple, const TString
 
 
 
+void STrackCutStudy::SetClusterSummary(const TString sSummaryFile, const TString sSummaryTuple) {
+
+  doClustSummary = (sSummaryFile != "");
+  sClustSumFile  = sSummaryFile;
+  sClustSumTuple = sSummaryTuple;
+  if (doClustSummary) {
+    cout << "    Set embed-only cluster summary:\n"
+         << "      File  = " << sClustSumFile.Data() << "\n"
+         << "      Tuple = " << sClustSumTuple.Data()
+         << endl;
+  }
+  return;
+
+}  // end 'SetClusterSummary(TString, TString)'
+
+
+
+void STrackCutStudy::SetEventGrouping(const Bool_t groupEvents) {
+
+  doEventGroups = groupEvents;
+  if (doEventGroups) {
+    cout << "    Will process tracks event by event (multiplicity from event index)." << endl;
+  } else {
+    cout << "    Will process tracks entry by entry." << endl;
+  }
+  return;
+
+}  // end 'SetEventGrouping(Bool_t)'
+
+
+
+void STrackCutStudy::SetDupGhost(const Bool_t dupGhost) {
+
+  doDupGhost = dupGhost;
+  if (doDupGhost) {
+    cout << "    Will look for duplicate and ghost tracks." << endl;
+  } else {
+    cout << "    Will not look for duplicate and ghost tracks." << endl;
+  }
+  return;
+
+}  // end 'SetDupGhost(Bool_t)'
+
+
+
+void STrackCutStudy::SetGhostParameters(const Double_t purityMin) {
+
+  ghostPurityMin = purityMin;
+  cout << "    Set ghost parameters:\n"
+       << "      Min. truth purity = " << ghostPurityMin
+       << endl;
+  return;
+
+}  // end 'SetGhostParameters(Double_t)'
+
+
+
+void STrackCutStudy::SetTruthTuple(const TString sTruthTuple) {
+
+  doEfficiency = (sTruthTuple != "");
+  sInTruthEO   = sTruthTuple;
+  if (doEfficiency) {
+    cout << "    Set input truth tuple (for efficiencies):\n"
+         << "      Embed-only truth tuple = " << sInTruthEO.Data()
+         << endl;
+  }
+  return;
+
+}  // end 'SetTruthTuple(TString)'
+
+
+
+void STrackCutStudy::SetPairedMode(const Bool_t pairSamples) {
+
+  doPairing = pairSamples;
+  if (doPairing) {
+    cout << "    Will pair with-pileup tracks with embed-only tracks of the same particle." << endl;
+  }
+  return;
+
+}  // end 'SetPairedMode(Bool_t)'
+
+
+
+void STrackCutStudy::SetCandidateInput(const TString sCandidateInput, const TString sCandidateTuple) {
+
+  doCandidate  = (sCandidateInput != "");
+  sInFileCand  = sCandidateInput;
+  sInTupleCand = sCandidateTuple;
+  if (doCandidate) {
+    cout << "    Set candidate input (embed-only input is the baseline):\n"
+         << "      Candidate file  = " << sInFileCand.Data() << "\n"
+         << "      Candidate tuple = " << sInTupleCand.Data()
+         << endl;
+  }
+  return;
+
+}  // end 'SetCandidateInput(TString, TString)'
+
+
+
 void STrackCutStudy::SetStudyParameters(const Bool_t plots, const Bool_t pileup, const Bool_t intNorm, const Bool_t beforeCuts, const Bool_t avgClustCalc, const Double_t normalFracMin, const Double_t normalFracMax) {
 
   makePlots       = plots;
@@ -180,6 +281,157 @@ void STrackCutStudy::SetPlotText(const Ssiz_t nTxtE, const Ssiz_t nTxtP, const T
 
 
 
+void STrackCutStudy::SetOutputParameters(const Int_t compAlgo, const Int_t compLevel, const UInt_t nThreads) {
+
+  compSettings = ROOT::CompressionSettings((ROOT::RCompressionSetting::EAlgorithm::EValues) compAlgo, compLevel);
+  nSaveThreads = (nThreads > 0) ? nThreads : 1;
+  cout << "    Set output parameters:\n"
+       << "      Compression algorithm = " << compAlgo     << "\n"
+       << "      Compression level     = " << compLevel    << "\n"
+       << "      Compression settings  = " << compSettings << "\n"
+       << "      No. of save threads   = " << nSaveThreads
+       << endl;
+  return;
+
+}  // end 'SetOutputParameters(Int_t, Int_t, UInt_t)'
+
+
+
+void STrackCutStudy::SetCheckpointParameters(const Bool_t checkpoint, const Bool_t resume, const TString sCheckpoint, const Double_t interval) {
+
+  doCheckpoint  = checkpoint;
+  doResume      = resume;
+  sCheckFile    = sCheckpoint;
+  checkInterval = interval;
+  cout << "    Set checkpoint parameters:\n"
+       << "      Checkpoint file     = " << sCheckFile.Data() << "\n"
+       << "      Checkpoint interval = " << checkInterval << " s"
+       << endl;
+
+  if (doCheckpoint) {
+    cout << "    Will write checkpoints." << endl;
+  } else {
+    cout << "    Will not write checkpoints." << endl;
+  }
+
+  if (doResume) {
+    cout << "    Will resume from checkpoint." << endl;
+  } else {
+    cout << "    Will not resume from checkpoint." << endl;
+  }
+  return;
+
+}  // end 'SetCheckpointParameters(Bool_t, Bool_t, TString, Double_t)'
+
+
+
+void STrackCutStudy::SetSparseOutput(const Bool_t sparse) {
+
+  doSparseOutput = sparse;
+  if (doSparseOutput) {
+    cout << "    Will save 2D histograms as sparse histograms." << endl;
+  } else {
+    cout << "    Will save 2D histograms as dense histograms." << endl;
+  }
+  return;
+
+}  // end 'SetSparseOutput(Bool_t)'
+
+
+
+void STrackCutStudy::SetRebinPyramid(const vector<UInt_t> levels) {
+
+  pyramidLevels.clear();
+  for (const UInt_t nRebin : levels) {
+    if (nRebin > 1) pyramidLevels.push_back(nRebin);
+  }
+
+  if (pyramidLevels.empty()) {
+    cout << "    Will not save rebinned histograms." << endl;
+  } else {
+    cout << "    Will save rebinned histograms at levels:";
+    for (const UInt_t nRebin : pyramidLevels) cout << " x" << nRebin;
+    cout << endl;
+  }
+  return;
+
+}  // end 'SetRebinPyramid(vector<UInt_t>)'
+
+
+
+void STrackCutStudy::SetFillFamilies(const vector<TString> families) {
+
+  // families are named as in 'sPlotFams' ("" is the plain spectrum)
+  for (Ssiz_t iFam = 0; iFam < NPlotFam; iFam++) {
+    doFamFill[iFam] = false;
+  }
+  for (const TString &sFam : families) {
+    Bool_t isKnown(false);
+    for (Ssiz_t iFam = 0; iFam < NPlotFam; iFam++) {
+      if (sFam != sPlotFams[iFam]) continue;
+      doFamFill[iFam] = true;
+      isKnown         = true;
+    }
+    if (!isKnown) cerr << "WARNING: unknown histogram family '" << sFam.Data() << "', ignoring!" << endl;
+  }
+
+  cout << "    Will fill histogram families:";
+  for (Ssiz_t iFam = 0; iFam < NPlotFam; iFam++) {
+    if (doFamFill[iFam]) cout << " '" << sPlotFams[iFam].Data() << "'";
+  }
+  cout << endl;
+  return;
+
+}  // end 'SetFillFamilies(vector<TString>)'
+
+
+
+void STrackCutStudy::SetPlotOnly(const TString sStudyOutput) {
+
+  doPlotOnly = true;
+  makePlots  = true;
+  sInPlot    = sStudyOutput;
+  cout << "    Set plot-only mode:\n"
+       << "      Study output = " << sInPlot.Data()
+       << endl;
+  return;
+
+}  // end 'SetPlotOnly(TString)'
+
+
+
+void STrackCutStudy::SetPlotParameters(const UInt_t nWorkers, const Bool_t exportImages, const TString sImages) {
+
+  nPlotWorkers  = (nWorkers > 0) ? nWorkers : 1;
+  doImageExport = exportImages;
+  sImageDir     = sImages;
+  cout << "    Set plot parameters:\n"
+       << "      No. of plot workers = " << nPlotWorkers
+       << endl;
+
+  if (doImageExport) {
+    cout << "    Will export plots as images to '" << sImageDir.Data() << "'." << endl;
+  } else {
+    cout << "    Will not export plots as images." << endl;
+  }
+  return;
+
+}  // end 'SetPlotParameters(UInt_t, Bool_t, TString)'
+
+
+
+void STrackCutStudy::SetPlotCache(const TString sPrevious) {
+
+  sPrevPlot = sPrevious;
+  cout << "    Set plot cache:\n"
+       << "      Previous output = " << sPrevPlot.Data()
+       << endl;
+  return;
+
+}  // end 'SetPlotCache(TString)'
+
+
+
 void STrackCutStudy::InitFiles() {
 
   // open files
@@ -192,6 +444,21 @@ void STrackCutStudy::InitFiles() {
          << endl;
     assert(fOut && fInEO && fInPU);
   }
+
+  if (doCandidate) {
+    fInCand = new TFile(sInFileCand.Data(), "read");
+    if (!fInCand || fInCand -> IsZombie()) {
+      cerr << "PANIC: couldn't open candidate file!\n"
+           << "       fInCand = " << fInCand << "\n"
+           << endl;
+      assert(fInCand && !fInCand -> IsZombie());
+    }
+  }
+
+  // set output compression (if specified)
+  if (compSettings >= 0) {
+    fOut -> SetCompressionSettings(compSettings);
+  }
   cout << "      Initialized files." << endl;
   return;
 
@@ -220,7 +487,7 @@ void STrackCutStudy::InitTuples() {
     }
   }
 
-  if (doAvgClustCalc) {
+  if (doAvgClustCalc && !doClustSummary) {
     ntClustEO = (TNtuple*) fInEO -> Get(sInClustEO.Data());
     if (!ntClustEO) {
       cerr << "PANIC: couldn't grab an input cluster NTuple!\n"
@@ -229,6 +496,38 @@ void STrackCutStudy::InitTuples() {
       assert(ntClustEO);
     }
   }
+
+  if (doCandidate) {
+    ntCandEO = (TNtuple*) fInCand -> Get(sInTupleCand.Data());
+    if (!ntCandEO) {
+      cerr << "PANIC: couldn't grab candidate NTuple!\n"
+           << "       ntCandEO = " << ntCandEO << "\n"
+           << endl;
+      assert(ntCandEO);
+    }
+  }
+
+  if (doEfficiency) {
+    ntTruEO = (TNtuple*) fInEO -> Get(sInTruthEO.Data());
+    if (!ntTruEO) {
+      cerr << "PANIC: couldn't grab an input truth NTuple!\n"
+           << "       ntTruEO = " << ntTruEO << "\n"
+           << endl;
+      assert(ntTruEO);
+    }
+  }
+
+  // summary is aligned entry-for-entry with embed-only tuple, so it's read as a friend
+  if (doClustSummary) {
+    TFriendElement *summary = ntTrkEO -> AddFriend(sClustSumTuple.Data(), sClustSumFile.Data());
+    TTree          *ntSum   = summary ? summary -> GetTree() : NULL;
+    if (!ntSum || (ntSum -> GetEntries() != ntTrkEO -> GetEntries())) {
+      cerr << "PANIC: cluster summary is missing or doesn't match embed-only tuple!\n"
+           << "       ntSum = " << ntSum << ", entries = " << (ntSum ? ntSum -> GetEntries() : -1) << " vs. " << ntTrkEO -> GetEntries() << "\n"
+           << endl;
+      assert(ntSum && (ntSum -> GetEntries() == ntTrkEO -> GetEntries()));
+    }
+  }
   cout << "      Initialized input ntuples." << endl;
 
   // set embed-only branch addresses
@@ -325,6 +624,19 @@ void STrackCutStudy::InitTuples() {
   ntTrkEO -> SetBranchAddress("nclusintt",       &nclusintt);
   ntTrkEO -> SetBranchAddress("nclusmaps",       &nclusmaps);
   ntTrkEO -> SetBranchAddress("nclusmms",        &nclusmms);
+  if (doClustSummary) {
+    ntTrkEO -> SetBranchAddress((sClustSumTuple + ".nclust").Data(),       &cs_nclust);
+    ntTrkEO -> SetBranchAddress((sClustSumTuple + ".avgclustsize").Data(), &cs_avgclustsize);
+  }
+
+  // candidate has the same leaves as the embed-only tuple, and is read into the same members
+  if (doCandidate) {
+    TObjArray *branches = ntTrkEO -> GetListOfBranches();
+    for (Int_t iBranch = 0; iBranch < branches -> GetEntriesFast(); iBranch++) {
+      TBranch *branch = (TBranch*) branches -> At(iBranch);
+      ntCandEO -> SetBranchAddress(branch -> GetName(), branch -> GetAddress());
+    }
+  }
 
   // set with-pileup branch
   if (doPileup) {
@@ -439,55 +751,688 @@ void STrackCutStudy::InitTuples() {
 
 void STrackCutStudy::SaveHists() {
 
-  // create output directories
-  TDirectory *dOut[NType];
-  for (UInt_t iDir = 0; iDir < NType; iDir++) {
-   
-    // check if directory should be created
-    if (isBeforeCuts[iDir] || isPileup[iDir]) {
-      if (isBeforeCuts[iDir] && !doBeforeCuts) continue;
-      if (isPileup[iDir]     && !doPileup)     continue;
-    }
-
-    // create directory 
-    fOut       -> cd();
-    dOut[iDir] = (TDirectory*) fOut -> mkdir(sTrkNames[iDir].Data());
-  }
-  cout << "      Made directories." << endl;
-
-  // save histograms
-  for (int iType = 0; iType < NType; iType++) {
+  // determine which types to save
+  vector<Int_t> typesToSave;
+  for (Int_t iType = 0; iType < NType; iType++) {
 
     // check if histograms should be saved
     if (isBeforeCuts[iType] || isPileup[iType]) {
       if (isBeforeCuts[iType] && !doBeforeCuts) continue;
       if (isPileup[iType]     && !doPileup)     continue;
     }
+    if (isCandidate[iType] && !doCandidate) continue;
+    if (isDupGhost[iType]  && !doDupGhost)  continue;
+    typesToSave.push_back(iType);
+  }
+
+  // keep cut text for standalone plotting
+  fOut -> WriteTObject(ptCut, "ptCut");
+  if (hDupMult) fOut -> WriteTObject(hDupMult, "hDupMult");
+  if (doEfficiency)             SaveEfficiencies();
+  if (doPairing || doCandidate) SavePairedHists();
+
+  // rebinned copies shouldn't be attached to any directory (they're
+  // made while other threads may be writing)
+  const Bool_t addDirectory = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(false);
+
+  // serial mode: write directly into output
+  if (nSaveThreads < 2) {
+    for (const Int_t iType : typesToSave) {
+      fOut -> cd();
+      TDirectory *dOut = (TDirectory*) fOut -> mkdir(sTrkNames[iType].Data());
+      WriteTypeHists(iType, dOut);
+      for (const UInt_t nRebin : pyramidLevels) {
+        fOut -> cd();
+        TDirectory *dLevel = (TDirectory*) fOut -> mkdir(GetPyramidDir(iType, nRebin).Data());
+        WriteTypeHists(iType, dLevel, nRebin);
+      }
+    }
+    TH1::AddDirectory(addDirectory);
+    cout << "      Saved histograms." << endl;
+    return;
+  }
+
+  // parallel mode: each type is serialized and compressed in its own
+  // in-memory file, and the merger folds them into the output. The
+  // merger takes ownership of (and closes) the output file.
+  ROOT::EnableThreadSafety();
+  {
+    ROOT::TBufferMerger merger(unique_ptr<TFile>(fOut));
+    ROOT::TThreadExecutor pool(nSaveThreads);
+    pool.Foreach([&](const Int_t iType) {
+      auto        fType = merger.GetFile();
+      TDirectory *dOut  = fType -> mkdir(sTrkNames[iType].Data());
+      WriteTypeHists(iType, dOut);
+      for (const UInt_t nRebin : pyramidLevels) {
+        TDirectory *dLevel = fType -> mkdir(GetPyramidDir(iType, nRebin).Data());
+        WriteTypeHists(iType, dLevel, nRebin);
+      }
+      fType -> Write();
+    }, typesToSave);
+  }
+  TH1::AddDirectory(addDirectory);
+  fOut = NULL;
+
+  cout << "      Saved histograms (" << nSaveThreads << " threads)." << endl;
+  return;
+
+}  // end 'SaveHists()'
+
+
+
+void STrackCutStudy::WriteTypeHists(const Int_t type, TDirectory *dOut, const UInt_t nRebin) {
+
+  for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+    WriteHist(hTrkVar[type][iTrkVar], dOut, nRebin);
+    WriteHist(hTrkVarDiff[type][iTrkVar], dOut, nRebin);
+    WriteHist(hTrkVarFrac[type][iTrkVar], dOut, nRebin);
+    WriteHist(hTrkVarVsNTpc[type][iTrkVar], dOut, nRebin);
+    WriteHist(hTrkVarVsDcaXY[type][iTrkVar], dOut, nRebin);
+    WriteHist(hTrkVarVsDcaZ[type][iTrkVar], dOut, nRebin);
+    WriteHist(hTrkVarVsPtReco[type][iTrkVar], dOut, nRebin);
+    WriteHist(hTrkVarVsPtTrue[type][iTrkVar], dOut, nRebin);
+    WriteHist(hTrkVarVsPtFrac[type][iTrkVar], dOut, nRebin);
+    if (doEventGroups) WriteHist(hTrkVarVsMult[type][iTrkVar], dOut, nRebin);
+  }
+  for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+    WriteHist(hPhysVar[type][iPhysVar], dOut, nRebin);
+    WriteHist(hPhysVarDiff[type][iPhysVar], dOut, nRebin);
+    WriteHist(hPhysVarFrac[type][iPhysVar], dOut, nRebin);
+    WriteHist(hPhysVarVsNTpc[type][iPhysVar], dOut, nRebin);
+    WriteHist(hPhysVarVsDcaXY[type][iPhysVar], dOut, nRebin);
+    WriteHist(hPhysVarVsDcaZ[type][iPhysVar], dOut, nRebin);
+    WriteHist(hPhysVarVsPtReco[type][iPhysVar], dOut, nRebin);
+    WriteHist(hPhysVarVsPtTrue[type][iPhysVar], dOut, nRebin);
+    WriteHist(hPhysVarVsPtFrac[type][iPhysVar], dOut, nRebin);
+    if (doEventGroups) WriteHist(hPhysVarVsMult[type][iPhysVar], dOut, nRebin);
+  }
+  return;
+
+}  // end 'WriteTypeHists(Int_t, TDirectory*, UInt_t)'
+
+
+
+void STrackCutStudy::SaveEfficiencies() {
+
+  TDirectory *dEff = fOut -> mkdir("Efficiency");
+  for (Ssiz_t iLevel = 0; iLevel < NCutLevel; iLevel++) {
+    for (Ssiz_t iEffVar = 0; iEffVar < NEffVar; iEffVar++) {
+      dEff -> WriteTObject(eTrkEff[iLevel][iEffVar]);
+      dEff -> WriteTObject(eTrkFake[iLevel][iEffVar]);
+    }
+  }
+  cout << "      Saved efficiencies." << endl;
+  return;
+
+}  // end 'SaveEfficiencies()'
+
+
+
+void STrackCutStudy::SavePairedHists() {
 
-    dOut[iType] -> cd(); 
+  const Bool_t isPairOn[NPairMode] = {doPairing, doCandidate};
+
+  TDirectory *dPair = fOut -> mkdir("PairedDiff");
+  for (Ssiz_t iMode = 0; iMode < NPairMode; iMode++) {
+    if (!isPairOn[iMode]) continue;
     for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
-      hTrkVar[iType][iTrkVar]         -> Write();
-      hTrkVarDiff[iType][iTrkVar]     -> Write();
-      hTrkVarFrac[iType][iTrkVar]     -> Write();
-      hTrkVarVsNTpc[iType][iTrkVar]   -> Write();
-      hTrkVarVsPtReco[iType][iTrkVar] -> Write();
-      hTrkVarVsPtTrue[iType][iTrkVar] -> Write();
-      hTrkVarVsPtFrac[iType][iTrkVar] -> Write();
+      dPair -> WriteTObject(hPairTrkDiff[iMode][iTrkVar]);
+      dPair -> WriteTObject(hPairTrkDiffVsPtTrue[iMode][iTrkVar]);
     }
     for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
-      hPhysVar[iType][iPhysVar]         -> Write();
-      hPhysVarDiff[iType][iPhysVar]     -> Write();
-      hPhysVarFrac[iType][iPhysVar]     -> Write();
-      hPhysVarVsNTpc[iType][iPhysVar]   -> Write();
-      hPhysVarVsPtReco[iType][iPhysVar] -> Write();
-      hPhysVarVsPtTrue[iType][iPhysVar] -> Write();
-      hPhysVarVsPtFrac[iType][iPhysVar] -> Write();
+      dPair -> WriteTObject(hPairPhysDiff[iMode][iPhysVar]);
+      dPair -> WriteTObject(hPairPhysDiffVsPtTrue[iMode][iPhysVar]);
     }
-  }  // end type loop
+  }
+  cout << "      Saved paired differences." << endl;
+  return;
+
+}  // end 'SavePairedHists()'
+
+
+
+void STrackCutStudy::WriteHist(TH1 *hist, TDirectory *dOut, const UInt_t nRebin) {
+
+  // pyramid levels are written from a rebinned copy, and only
+  // if the level divides the no. of bins along every axis
+  if (nRebin > 1) {
+    const Bool_t is2D        = (hist -> GetDimension() == 2);
+    const Bool_t isDivisible = ((hist -> GetNbinsX() % nRebin) == 0) && (!is2D || ((hist -> GetNbinsY() % nRebin) == 0));
+    if (!isDivisible) return;
+
+    TH1 *hRebin = (TH1*) hist -> Clone();
+    if (is2D) {
+      ((TH2*) hRebin) -> Rebin2D(nRebin, nRebin);
+    } else {
+      hRebin -> Rebin(nRebin);
+    }
+    WriteHist(hRebin, dOut);
+    delete hRebin;
+    return;
+  }
 
-  cout << "      Saved histograms." << endl;
+  // 1D histograms (and everything in dense mode) are written as-is
+  if (!doSparseOutput || (hist -> GetDimension() != 2)) {
+    dOut -> WriteTObject(hist);
+    return;
+  }
+
+  // otherwise copy only the filled bins (including under/overflow) into
+  // a sparse histogram of the same name and binning
+  const Int_t nDim(2);
+  TAxis      *axes[nDim] = {hist -> GetXaxis(), hist -> GetYaxis()};
+  Int_t       nBins[nDim];
+  Double_t    xMin[nDim];
+  Double_t    xMax[nDim];
+  for (Int_t iDim = 0; iDim < nDim; iDim++) {
+    nBins[iDim] = axes[iDim] -> GetNbins();
+    xMin[iDim]  = axes[iDim] -> GetXmin();
+    xMax[iDim]  = axes[iDim] -> GetXmax();
+  }
+
+  THnSparseD *hSparse = new THnSparseD(hist -> GetName(), hist -> GetTitle(), nDim, nBins, xMin, xMax);
+  for (Int_t iDim = 0; iDim < nDim; iDim++) {
+    if (axes[iDim] -> IsVariableBinSize()) {
+      hSparse -> SetBinEdges(iDim, axes[iDim] -> GetXbins() -> GetArray());
+    }
+    hSparse -> GetAxis(iDim) -> SetName(axes[iDim] -> GetName());
+    hSparse -> GetAxis(iDim) -> SetTitle(axes[iDim] -> GetTitle());
+  }
+  hSparse -> Sumw2();
+
+  Int_t iBin[nDim];
+  for (iBin[0] = 0; iBin[0] < (nBins[0] + 2); iBin[0]++) {
+    for (iBin[1] = 0; iBin[1] < (nBins[1] + 2); iBin[1]++) {
+      const Int_t    iCell   = hist -> GetBin(iBin[0], iBin[1]);
+      const Double_t content = hist -> GetBinContent(iCell);
+      const Double_t error   = hist -> GetBinError(iCell);
+      if ((content == 0.) && (error == 0.)) continue;
+
+      const Long64_t iSparse = hSparse -> GetBin(iBin, kTRUE);
+      hSparse -> SetBinContent(iSparse, content);
+      hSparse -> SetBinError2(iSparse, error * error);
+    }
+  }
+  hSparse -> SetEntries(hist -> GetEntries());
+
+  dOut -> WriteTObject(hSparse);
+  delete hSparse;
   return;
 
-}  // end 'SaveHists()'
+}  // end 'WriteHist(TH1*, TDirectory*, UInt_t)'
+
+
+
+TString STrackCutStudy::GetPyramidDir(const Int_t type, const UInt_t nRebin) {
+
+  TString sDir = sTrkNames[type];
+  sDir += "_Rebin";
+  sDir += nRebin;
+  return sDir;
+
+}  // end 'GetPyramidDir(Int_t, UInt_t)'
+
+
+
+void STrackCutStudy::InitPlotFiles() {
+
+  // open study output and file for plots
+  fInPlot = new TFile(sInPlot.Data(),  "read");
+  fOut    = new TFile(sOutfile.Data(), "recreate");
+  if (!fInPlot || fInPlot -> IsZombie() || !fOut) {
+    cerr << "PANIC: couldn't open a file!\n"
+         << "       fInPlot = " << fInPlot << ", fOut = " << fOut << "\n"
+         << endl;
+    assert(fInPlot && !fInPlot -> IsZombie() && fOut);
+  }
+
+  // nothing is loaded until a canvas needs it
+  for (Int_t iType = 0; iType < NType; iType++) {
+    for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+      hTrkVar[iType][iTrkVar]         = NULL;
+      hTrkVarDiff[iType][iTrkVar]     = NULL;
+      hTrkVarFrac[iType][iTrkVar]     = NULL;
+      hTrkVarVsNTpc[iType][iTrkVar]   = NULL;
+      hTrkVarVsDcaXY[iType][iTrkVar]  = NULL;
+      hTrkVarVsDcaZ[iType][iTrkVar]   = NULL;
+      hTrkVarVsPtReco[iType][iTrkVar] = NULL;
+      hTrkVarVsPtTrue[iType][iTrkVar] = NULL;
+      hTrkVarVsPtFrac[iType][iTrkVar] = NULL;
+      hTrkVarVsMult[iType][iTrkVar]   = NULL;
+    }
+    for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+      hPhysVar[iType][iPhysVar]         = NULL;
+      hPhysVarDiff[iType][iPhysVar]     = NULL;
+      hPhysVarFrac[iType][iPhysVar]     = NULL;
+      hPhysVarVsNTpc[iType][iPhysVar]   = NULL;
+      hPhysVarVsDcaXY[iType][iPhysVar]  = NULL;
+      hPhysVarVsDcaZ[iType][iPhysVar]   = NULL;
+      hPhysVarVsPtReco[iType][iPhysVar] = NULL;
+      hPhysVarVsPtTrue[iType][iPhysVar] = NULL;
+      hPhysVarVsPtFrac[iType][iPhysVar] = NULL;
+      hPhysVarVsMult[iType][iPhysVar]   = NULL;
+    }
+  }
+
+  // which types were saved
+  doBeforeCuts = (fInPlot -> GetDirectory(sTrkNames[TYPE::TRACK].Data())    != NULL);
+  doPileup     = (fInPlot -> GetDirectory(sTrkNames[TYPE::PILE_CUT].Data()) != NULL);
+  doDupGhost   = (fInPlot -> GetDirectory(sTrkNames[TYPE::DUPL_CUT].Data()) != NULL);
+  doCandidate  = (fInPlot -> GetDirectory(sTrkNames[TYPE::CAND_CUT].Data()) != NULL);
+
+  // multiplicity hists are only saved when entries were grouped by event
+  TDirectory *dTrkCut = fInPlot -> GetDirectory(sTrkNames[TYPE::TRK_CUT].Data());
+  if (dTrkCut) {
+    const TString sMultName = "h" + sTrkVars[0] + "VsMult_" + sTrkNames[TYPE::TRK_CUT];
+    doEventGroups = (dTrkCut -> FindKey(sMultName.Data()) != NULL);
+  }
+
+  // use saved cut text if available
+  TPaveText *ptSaved = (TPaveText*) fInPlot -> Get("ptCut");
+  if (ptSaved) {
+    ptCut = ptSaved;
+  } else {
+    MakeCutText();
+  }
+  cout << "      Initialized files for plotting." << endl;
+  return;
+
+}  // end 'InitPlotFiles()'
+
+
+
+void STrackCutStudy::InitPlotCache() {
+
+  if (sPrevPlot == "") return;
+  if (gSystem -> AccessPathName(sPrevPlot.Data())) {
+    cout << "      No previous output '" << sPrevPlot.Data() << "', making all plots." << endl;
+    return;
+  }
+
+  // output would be recreated on top of the previous one
+  if (sPrevPlot == sOutfile) {
+    const TString sMoved = sOutfile + ".previous";
+    gSystem -> Rename(sPrevPlot.Data(), sMoved.Data());
+    sPrevPlot = sMoved;
+  }
+
+  fPrevPlot = new TFile(sPrevPlot.Data(), "read");
+  if (!fPrevPlot || fPrevPlot -> IsZombie()) {
+    cerr << "WARNING: couldn't open previous output '" << sPrevPlot.Data() << "', making all plots." << endl;
+    fPrevPlot = NULL;
+    return;
+  }
+  cout << "      Opened previous output: unchanged plots will be copied from it." << endl;
+  return;
+
+}  // end 'InitPlotCache()'
+
+
+
+void STrackCutStudy::ClosePlotCache() {
+
+  if (!fPrevPlot) return;
+  fPrevPlot -> Close();
+  delete fPrevPlot;
+  fPrevPlot = NULL;
+
+  // a previous output moved aside for the cache isn't needed anymore
+  if (sPrevPlot == (sOutfile + ".previous")) {
+    gSystem -> Unlink(sPrevPlot.Data());
+    cout << "      Removed previous output '" << sPrevPlot.Data() << "'." << endl;
+  }
+  return;
+
+}  // end 'ClosePlotCache()'
+
+
+
+void STrackCutStudy::LoadVarHists(const Ssiz_t nToDraw, const Int_t typesToDraw[], const Int_t iVar, const Bool_t isTrkVar) {
+
+  for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
+    const Int_t iType = typesToDraw[iToDraw];
+
+    TDirectory *dType = fInPlot -> GetDirectory(sTrkNames[iType].Data());
+    if (!dType) {
+      cerr << "PANIC: study output has no directory for type '" << sTrkNames[iType].Data() << "'!" << endl;
+      assert(dType);
+    }
+
+    const TString sSuffix = "_" + sTrkNames[iType];
+    if (isTrkVar) {
+      const TString sName = "h" + sTrkVars[iVar];
+      hTrkVar[iType][iVar]         = (TH1D*) ReadHist(dType, sName              + sSuffix);
+      hTrkVarDiff[iType][iVar]     = (TH1D*) ReadHist(dType, sName + "Diff"     + sSuffix);
+      hTrkVarFrac[iType][iVar]     = (TH1D*) ReadHist(dType, sName + "Frac"     + sSuffix);
+      hTrkVarVsNTpc[iType][iVar]   = (TH2D*) ReadHist(dType, sName + "VsNTpc"   + sSuffix);
+      hTrkVarVsDcaXY[iType][iVar]  = (TH2D*) ReadHist(dType, sName + "VsDcaXY"  + sSuffix);
+      hTrkVarVsDcaZ[iType][iVar]   = (TH2D*) ReadHist(dType, sName + "VsDcaZ"   + sSuffix);
+      hTrkVarVsPtReco[iType][iVar] = (TH2D*) ReadHist(dType, sName + "VsPtReco" + sSuffix);
+      hTrkVarVsPtTrue[iType][iVar] = (TH2D*) ReadHist(dType, sName + "VsPtTrue" + sSuffix);
+      hTrkVarVsPtFrac[iType][iVar] = (TH2D*) ReadHist(dType, sName + "VsPtFrac" + sSuffix);
+      if (doEventGroups) hTrkVarVsMult[iType][iVar] = (TH2D*) ReadHist(dType, sName + "VsMult" + sSuffix);
+    } else {
+      const TString sName = "h" + sPhysVars[iVar];
+      hPhysVar[iType][iVar]         = (TH1D*) ReadHist(dType, sName              + sSuffix);
+      hPhysVarDiff[iType][iVar]     = (TH1D*) ReadHist(dType, sName + "Diff"     + sSuffix);
+      hPhysVarFrac[iType][iVar]     = (TH1D*) ReadHist(dType, sName + "Frac"     + sSuffix);
+      hPhysVarVsNTpc[iType][iVar]   = (TH2D*) ReadHist(dType, sName + "VsNTpc"   + sSuffix);
+      hPhysVarVsDcaXY[iType][iVar]  = (TH2D*) ReadHist(dType, sName + "VsDcaXY"  + sSuffix);
+      hPhysVarVsDcaZ[iType][iVar]   = (TH2D*) ReadHist(dType, sName + "VsDcaZ"   + sSuffix);
+      hPhysVarVsPtReco[iType][iVar] = (TH2D*) ReadHist(dType, sName + "VsPtReco" + sSuffix);
+      hPhysVarVsPtTrue[iType][iVar] = (TH2D*) ReadHist(dType, sName + "VsPtTrue" + sSuffix);
+      hPhysVarVsPtFrac[iType][iVar] = (TH2D*) ReadHist(dType, sName + "VsPtFrac" + sSuffix);
+      if (doEventGroups) hPhysVarVsMult[iType][iVar] = (TH2D*) ReadHist(dType, sName + "VsMult" + sSuffix);
+    }
+  }
+
+  // apply current styles to what was just loaded
+  SetHistStyles();
+  return;
+
+}  // end 'LoadVarHists(Ssiz_t, Int_t[], Int_t, Bool_t)'
+
+
+
+void STrackCutStudy::ReleaseVarHists(const Ssiz_t nToDraw, const Int_t typesToDraw[], const Int_t iVar, const Bool_t isTrkVar) {
+
+  for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
+    const Int_t iType = typesToDraw[iToDraw];
+    if (isTrkVar) {
+      delete hTrkVar[iType][iVar];
+      delete hTrkVarDiff[iType][iVar];
+      delete hTrkVarFrac[iType][iVar];
+      delete hTrkVarVsNTpc[iType][iVar];
+      delete hTrkVarVsDcaXY[iType][iVar];
+      delete hTrkVarVsDcaZ[iType][iVar];
+      delete hTrkVarVsPtReco[iType][iVar];
+      delete hTrkVarVsPtTrue[iType][iVar];
+      delete hTrkVarVsPtFrac[iType][iVar];
+      delete hTrkVarVsMult[iType][iVar];
+      hTrkVar[iType][iVar]         = NULL;
+      hTrkVarDiff[iType][iVar]     = NULL;
+      hTrkVarFrac[iType][iVar]     = NULL;
+      hTrkVarVsNTpc[iType][iVar]   = NULL;
+      hTrkVarVsDcaXY[iType][iVar]  = NULL;
+      hTrkVarVsDcaZ[iType][iVar]   = NULL;
+      hTrkVarVsPtReco[iType][iVar] = NULL;
+      hTrkVarVsPtTrue[iType][iVar] = NULL;
+      hTrkVarVsPtFrac[iType][iVar] = NULL;
+      hTrkVarVsMult[iType][iVar]   = NULL;
+    } else {
+      delete hPhysVar[iType][iVar];
+      delete hPhysVarDiff[iType][iVar];
+      delete hPhysVarFrac[iType][iVar];
+      delete hPhysVarVsNTpc[iType][iVar];
+      delete hPhysVarVsDcaXY[iType][iVar];
+      delete hPhysVarVsDcaZ[iType][iVar];
+      delete hPhysVarVsPtReco[iType][iVar];
+      delete hPhysVarVsPtTrue[iType][iVar];
+      delete hPhysVarVsPtFrac[iType][iVar];
+      delete hPhysVarVsMult[iType][iVar];
+      hPhysVar[iType][iVar]         = NULL;
+      hPhysVarDiff[iType][iVar]     = NULL;
+      hPhysVarFrac[iType][iVar]     = NULL;
+      hPhysVarVsNTpc[iType][iVar]   = NULL;
+      hPhysVarVsDcaXY[iType][iVar]  = NULL;
+      hPhysVarVsDcaZ[iType][iVar]   = NULL;
+      hPhysVarVsPtReco[iType][iVar] = NULL;
+      hPhysVarVsPtTrue[iType][iVar] = NULL;
+      hPhysVarVsPtFrac[iType][iVar] = NULL;
+      hPhysVarVsMult[iType][iVar]   = NULL;
+    }
+  }
+  return;
+
+}  // end 'ReleaseVarHists(Ssiz_t, Int_t[], Int_t, Bool_t)'
+
+
+
+TH1* STrackCutStudy::ReadHist(TDirectory *dIn, const TString sHist) {
+
+  TObject *obj = dIn -> Get(sHist.Data());
+  if (!obj) {
+    cerr << "PANIC: couldn't grab histogram '" << sHist.Data() << "' from " << dIn -> GetName() << "!" << endl;
+    assert(obj);
+  }
+
+  // dense histograms are used as-is
+  if (obj -> InheritsFrom(TH1::Class())) {
+    TH1 *hist = (TH1*) obj;
+    hist -> SetDirectory(0);
+    return hist;
+  }
+
+  // sparse histograms (see 'WriteHist') are densified the same way the macros do
+  TH1 *hDense = MakeDenseHist((THnBase*) obj);
+  if (!hDense) {
+    cerr << "PANIC: couldn't densify histogram '" << sHist.Data() << "'!" << endl;
+    assert(hDense);
+  }
+  hDense -> SetDirectory(0);
+  delete obj;
+  return hDense;
+
+}  // end 'ReadHist(TDirectory*, TString)'
+
+
+
+void STrackCutStudy::InitCheckpoint() {
+
+  // open checkpoint file (keeping histograms where they are)
+  TDirectory *dCurrent = gDirectory;
+  if (doResume) {
+    fCheck = new TFile(sCheckFile.Data(), "update");
+  } else {
+    fCheck = new TFile(sCheckFile.Data(), "recreate");
+  }
+  if (!fCheck || fCheck -> IsZombie()) {
+    cerr << "PANIC: couldn't open checkpoint file!\n"
+         << "       fCheck = " << fCheck << "\n"
+         << endl;
+    assert(fCheck && !fCheck -> IsZombie());
+  }
+  fCheck -> SetCompressionSettings(ROOT::CompressionSettings(ROOT::RCompressionSetting::EAlgorithm::kLZ4, 1));
+
+  // restore saved histograms and entries processed per type
+  if (doResume) {
+    iResume = -1;
+    for (Int_t iType = 0; iType < NType; iType++) {
+
+      // check if histograms are in use
+      if (isBeforeCuts[iType] || isPileup[iType]) {
+        if (isBeforeCuts[iType] && !doBeforeCuts) continue;
+        if (isPileup[iType]     && !doPileup)     continue;
+      }
+      if (isCandidate[iType] && !doCandidate) continue;
+      if (isDupGhost[iType]  && !doDupGhost)  continue;
+
+      TDirectory            *dType = fCheck -> GetDirectory(sTrkNames[iType].Data());
+      TParameter<Long64_t> *pDone = dType ? (TParameter<Long64_t>*) dType -> Get("nDone") : NULL;
+      if (pDone) {
+        vector<TH1*> hists;
+        GetTypeHists(iType, hists);
+        nCheckEntries[iType].assign(hists.size(), -1.);
+        for (size_t iHist = 0; iHist < hists.size(); iHist++) {
+          if (!hists[iHist]) continue;
+          TH1 *hSaved = (TH1*) dType -> Get(hists[iHist] -> GetName());
+          if (!hSaved) continue;
+          hists[iHist] -> Add(hSaved);
+          nCheckEntries[iType][iHist] = hists[iHist] -> GetEntries();
+          delete hSaved;
+        }
+        nDoneType[iType] = pDone -> GetVal();
+      }
+      if ((iResume < 0) || (nDoneType[iType] < iResume)) iResume = nDoneType[iType];
+    }
+    if (iResume < 0) iResume = 0;
+    cout << "      Restored checkpoint: resuming from entry " << iResume << "." << endl;
+  }
+  dCurrent -> cd();
+
+  // catch evictions
+  if (doCheckpoint) {
+    gotTermSignal = 0;
+    signal(SIGTERM, STrackCutStudy::CatchTermSignal);
+    tLastCheck = TTimeStamp().AsDouble();
+  }
+  cout << "      Initialized checkpoint." << endl;
+  return;
+
+}  // end 'InitCheckpoint()'
+
+
+
+Bool_t STrackCutStudy::CheckCheckpoint() {
+
+  // on SIGTERM, save everything and unwind the entry loops
+  if (gotTermSignal) {
+    UpdateCheckpoint(true);
+    isStopped = true;
+    cerr << "WARNING: caught SIGTERM! Wrote checkpoint at entry " << iCurrent << ", stopping." << endl;
+    return false;
+  }
+
+  // otherwise only look at the clock every so often
+  const Long64_t nCheckStride(1000);
+  if ((iCurrent % nCheckStride) != 0) return true;
+
+  const Double_t tNow = TTimeStamp().AsDouble();
+  if ((tNow - tLastCheck) < checkInterval) return true;
+
+  UpdateCheckpoint(false);
+  tLastCheck = tNow;
+  return true;
+
+}  // end 'CheckCheckpoint()'
+
+
+
+void STrackCutStudy::CloseCheckpoint() {
+
+  // a stopped run already wrote where it got to
+  if (!fCheck) return;
+  if (doCheckpoint && !isStopped) {
+    UpdateCheckpoint(true);
+    cout << "      Wrote final checkpoint." << endl;
+  }
+  fCheck -> Close();
+  delete fCheck;
+  fCheck = NULL;
+  return;
+
+}  // end 'CloseCheckpoint()'
+
+
+
+void STrackCutStudy::UpdateCheckpoint(const Bool_t doAllTypes) {
+
+  // write one type per update (or all of them) so the
+  // loop is never held up by the full set of histograms
+  Bool_t wroteType(false);
+  for (Int_t iStep = 0; iStep < NType; iStep++) {
+
+    const Int_t iType = (iNextCheck + iStep) % NType;
+    if (isBeforeCuts[iType] || isPileup[iType]) {
+      if (isBeforeCuts[iType] && !doBeforeCuts) continue;
+      if (isPileup[iType]     && !doPileup)     continue;
+    }
+    if (isCandidate[iType] && !doCandidate) continue;
+    if (isDupGhost[iType]  && !doDupGhost)  continue;
+
+    // types untouched since last write are still current
+    if (!isTypeDirty[iType] || (!doAllTypes && wroteType)) {
+      if (!isTypeDirty[iType]) {
+        nDoneType[iType] = iCurrent;
+        TDirectory *dType = fCheck -> GetDirectory(sTrkNames[iType].Data());
+        if (!dType) dType = fCheck -> mkdir(sTrkNames[iType].Data());
+        TParameter<Long64_t> pDone("nDone", nDoneType[iType]);
+        dType -> WriteTObject(&pDone, "nDone", "WriteDelete");
+      }
+      continue;
+    }
+
+    WriteTypeCheckpoint(iType);
+    wroteType  = true;
+    iNextCheck = (iType + 1) % NType;
+  }
+  fCheck -> Write();
+  fCheck -> Flush();
+  return;
+
+}  // end 'UpdateCheckpoint(Bool_t)'
+
+
+
+void STrackCutStudy::WriteTypeCheckpoint(const Int_t type) {
+
+  TDirectory *dType = fCheck -> GetDirectory(sTrkNames[type].Data());
+  if (!dType) dType = fCheck -> mkdir(sTrkNames[type].Data());
+
+  // write raw histograms filled since their last write, then mark how far they go
+  vector<TH1*> hists;
+  GetTypeHists(type, hists);
+  if (nCheckEntries[type].size() != hists.size()) {
+    nCheckEntries[type].assign(hists.size(), -1.);
+  }
+  for (size_t iHist = 0; iHist < hists.size(); iHist++) {
+    if (!hists[iHist]) continue;
+    if (hists[iHist] -> GetEntries() == nCheckEntries[type][iHist]) continue;
+    dType -> WriteTObject(hists[iHist], hists[iHist] -> GetName(), "WriteDelete");
+    nCheckEntries[type][iHist] = hists[iHist] -> GetEntries();
+  }
+
+  nDoneType[type]   = iCurrent;
+  isTypeDirty[type] = false;
+  TParameter<Long64_t> pDone("nDone", nDoneType[type]);
+  dType -> WriteTObject(&pDone, "nDone", "WriteDelete");
+  return;
+
+}  // end 'WriteTypeCheckpoint(Int_t)'
+
+
+
+void STrackCutStudy::GetTypeHists(const Int_t type, vector<TH1*> &hists) {
+
+  hists.clear();
+  for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+    hists.push_back(hTrkVar[type][iTrkVar]);
+    hists.push_back(hTrkVarDiff[type][iTrkVar]);
+    hists.push_back(hTrkVarFrac[type][iTrkVar]);
+    hists.push_back(hTrkVarVsNTpc[type][iTrkVar]);
+    hists.push_back(hTrkVarVsDcaXY[type][iTrkVar]);
+    hists.push_back(hTrkVarVsDcaZ[type][iTrkVar]);
+    hists.push_back(hTrkVarVsPtReco[type][iTrkVar]);
+    hists.push_back(hTrkVarVsPtTrue[type][iTrkVar]);
+    hists.push_back(hTrkVarVsPtFrac[type][iTrkVar]);
+    hists.push_back(hTrkVarVsMult[type][iTrkVar]);
+  }
+  for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+    hists.push_back(hPhysVar[type][iPhysVar]);
+    hists.push_back(hPhysVarDiff[type][iPhysVar]);
+    hists.push_back(hPhysVarFrac[type][iPhysVar]);
+    hists.push_back(hPhysVarVsNTpc[type][iPhysVar]);
+    hists.push_back(hPhysVarVsDcaXY[type][iPhysVar]);
+    hists.push_back(hPhysVarVsDcaZ[type][iPhysVar]);
+    hists.push_back(hPhysVarVsPtReco[type][iPhysVar]);
+    hists.push_back(hPhysVarVsPtTrue[type][iPhysVar]);
+    hists.push_back(hPhysVarVsPtFrac[type][iPhysVar]);
+    hists.push_back(hPhysVarVsMult[type][iPhysVar]);
+  }
+  return;
+
+}  // end 'GetTypeHists(Int_t, vector<TH1*>&)'
+
+
+
+volatile sig_atomic_t STrackCutStudy::gotTermSignal = 0;
+
+void STrackCutStudy::CatchTermSignal(int signal) {
+
+  gotTermSignal = 1;
+  return;
+
+}  // end 'CatchTermSignal(int)'
 
 // end ------------------------------------------------------------------------
@@ -107,6 +107,158 @@ void STrackCutStudy::MakeCutText() {
 
 
 
+void STrackCutStudy::MakePlots() {
+
+  // plot labels/directories to save in
+  const TString sGroupLabels[NPlotGroup] = {"EmbedOnly_AfterCuts",       "EmbedOnly_WeirdVsNormal",      "EmbedOnly_BeforeCuts",      "WithPileup_AfterCuts", "WithPileup_BeforeCuts",
+                                            "EmbedOnly_DuplicateVsGhost",      "EmbedOnly_DuplicateVsGhost_BeforeCuts",      "Candidate_AfterCuts",      "Candidate_BeforeCuts"};
+  const TString sGroupDirs[NPlotGroup]   = {"EmbedOnlyPlots_AfterCuts",  "EmbedOnlyPlots_WeirdVsNormal", "EmbedOnlyPlots_BeforeCuts", "CutWithPileupPlots",   "AllWithPileupPlots",
+                                            "EmbedOnlyPlots_DuplicateVsGhost", "EmbedOnlyPlots_DuplicateVsGhost_BeforeCuts", "CandidatePlots_AfterCuts", "CandidatePlots_BeforeCuts"};
+
+  // track types to plot together
+  const Int_t groupTypes[NPlotGroup][NGroupType] = {
+    {TYPE::TRK_CUT,      TYPE::TRU_CUT,       TYPE::WEIRD_CUT},
+    {TYPE::WEIRD_SI_CUT, TYPE::WEIRD_TPC_CUT, TYPE::NORM_CUT},
+    {TYPE::TRACK,        TYPE::TRUTH,         TYPE::WEIRD_ALL},
+    {TYPE::PILE_CUT,     TYPE::PRIM_CUT,      TYPE::NONPRIM_CUT},
+    {TYPE::PILEUP,       TYPE::PRIMARY,       TYPE::NONPRIM},
+    {TYPE::DUPL_CUT,     TYPE::GHOST_CUT,     TYPE::NORM_CUT},
+    {TYPE::DUPLICATE,    TYPE::GHOST,         TYPE::NORMAL},
+    {TYPE::TRK_CUT,      TYPE::CAND_CUT,      TYPE::TRU_CUT},
+    {TYPE::TRACK,        TYPE::CANDIDATE,     TYPE::TRUTH}
+  };
+  const Bool_t isGroupOn[NPlotGroup] = {true, true, doBeforeCuts, doPileup, (doPileup && doBeforeCuts), doDupGhost, (doDupGhost && doBeforeCuts),
+                                        doCandidate, (doCandidate && doBeforeCuts)};
+
+  // make image directories up front so workers don't race to
+  if (doImageExport) {
+    for (Ssiz_t iGroup = 0; iGroup < NPlotGroup; iGroup++) {
+      if (!isGroupOn[iGroup]) continue;
+      gSystem -> mkdir((sImageDir + "/" + sGroupDirs[iGroup]).Data(), true);
+    }
+  }
+
+  // create desired plots
+  if (nPlotWorkers > 1) {
+    MakePlotsInParallel(isGroupOn, groupTypes, sGroupDirs, sGroupLabels);
+  } else {
+    for (Ssiz_t iGroup = 0; iGroup < NPlotGroup; iGroup++) {
+      if (!isGroupOn[iGroup]) continue;
+      ConstructPlots(NGroupType, groupTypes[iGroup], sGroupDirs[iGroup], sGroupLabels[iGroup]);
+    }
+  }
+  if (doImageExport) WritePlotIndex(isGroupOn, sGroupDirs, sGroupLabels);
+  return;
+
+}  // end 'MakePlots()'
+
+
+
+void STrackCutStudy::MakePlotsInParallel(const Bool_t isGroupOn[], const Int_t groupTypes[][NGroupType], const TString sGroupDirs[], const TString sGroupLabels[]) {
+
+  // each worker renders every n-th variable into its own file
+  vector<TString> sWorkFiles(nPlotWorkers);
+  for (UInt_t iWorker = 0; iWorker < nPlotWorkers; iWorker++) {
+    sWorkFiles[iWorker]  = sOutfile;
+    sWorkFiles[iWorker] += TString::Format(".plotWorker%u.tmp.root", iWorker);
+  }
+  cout << "      Making plots with " << nPlotWorkers << " workers..." << endl;
+
+  // workers are forked processes since graphics aren't thread-safe
+  ROOT::TProcessExecutor pool(nPlotWorkers);
+  const vector<Int_t> status = pool.Map([&](const UInt_t iWorker) {
+
+    // the parent's output (and checkpoint) must not be closed when the worker exits
+    vector<TFile*> parentFiles;
+    TIter nextFile(gROOT -> GetListOfFiles());
+    while (TFile *file = (TFile*) nextFile()) {
+      if (file -> IsWritable()) parentFiles.push_back(file);
+    }
+    for (TFile *file : parentFiles) {
+      gROOT -> GetListOfFiles() -> Remove(file);
+    }
+    gROOT -> SetBatch(true);
+
+    // open private handles: a forked file descriptor shares its offset with the parent
+    if (doPlotOnly) fInPlot = new TFile(sInPlot.Data(), "read");
+    if (fPrevPlot)  fPrevPlot = new TFile(sPrevPlot.Data(), "read");
+    fOut = new TFile(sWorkFiles[iWorker].Data(), "recreate");
+    if (!fOut || fOut -> IsZombie() || (doPlotOnly && fInPlot -> IsZombie())) return 1;
+
+    // pick out variables for this worker
+    for (Ssiz_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+      doTrkVarPlot[iTrkVar] = ((iTrkVar % nPlotWorkers) == iWorker);
+    }
+    for (Ssiz_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+      doPhysVarPlot[iPhysVar] = (((NTrkVar + iPhysVar) % nPlotWorkers) == iWorker);
+    }
+
+    for (Ssiz_t iGroup = 0; iGroup < NPlotGroup; iGroup++) {
+      if (!isGroupOn[iGroup]) continue;
+      ConstructPlots(NGroupType, groupTypes[iGroup], sGroupDirs[iGroup], sGroupLabels[iGroup]);
+    }
+    fOut -> Close();
+    return 0;
+
+  }, ROOT::TSeqU(nPlotWorkers));
+
+  // check that every worker finished
+  Bool_t isGood = (status.size() == nPlotWorkers);
+  for (const Int_t result : status) {
+    if (result != 0) isGood = false;
+  }
+  if (!isGood) {
+    cerr << "PANIC: a plot worker failed!\n" << endl;
+    assert(isGood);
+  }
+
+  vector<TFile*> fWork(nPlotWorkers);
+  for (UInt_t iWorker = 0; iWorker < nPlotWorkers; iWorker++) {
+    fWork[iWorker] = new TFile(sWorkFiles[iWorker].Data(), "read");
+    if (!fWork[iWorker] || fWork[iWorker] -> IsZombie()) {
+      cerr << "PANIC: couldn't open output of plot worker " << iWorker << "!\n" << endl;
+      assert(fWork[iWorker] && !fWork[iWorker] -> IsZombie());
+    }
+  }
+
+  // copy canvases (and their hashes) into output in the same order as a serial run
+  for (Ssiz_t iGroup = 0; iGroup < NPlotGroup; iGroup++) {
+    if (!isGroupOn[iGroup]) continue;
+
+    TDirectory *dOut = fOut -> GetDirectory(sGroupDirs[iGroup].Data());
+    if (!dOut) dOut = fOut -> mkdir(sGroupDirs[iGroup].Data());
+
+    for (Ssiz_t iVar = 0; iVar < (NTrkVar + NPhysVar); iVar++) {
+      const Bool_t  isTrkVar = (iVar < NTrkVar);
+      const TString sVar     = isTrkVar ? sTrkVars[iVar] : sPhysVars[iVar - NTrkVar];
+      const UInt_t  iWorker  = iVar % nPlotWorkers;
+      for (Ssiz_t iFam = 0; iFam <= NPlotFam; iFam++) {
+        if ((iFam == PLOTFAM::FAM_VSMULT) && !doEventGroups) continue;
+        const TString sPlot = (iFam < NPlotFam) ? "c" + sVar + sPlotFams[iFam] + "_" + sGroupLabels[iGroup] : "md5_" + sVar;
+        TObject *plot = fWork[iWorker] -> Get((sGroupDirs[iGroup] + "/" + sPlot).Data());
+        if (!plot) {
+          cerr << "WARNING: plot worker " << iWorker << " didn't make '" << sPlot.Data() << "'!" << endl;
+          continue;
+        }
+        dOut -> cd();
+        plot -> Write(sPlot.Data());
+        delete plot;
+      }
+    }
+  }
+
+  // clean up
+  for (UInt_t iWorker = 0; iWorker < nPlotWorkers; iWorker++) {
+    fWork[iWorker] -> Close();
+    gSystem -> Unlink(sWorkFiles[iWorker].Data());
+  }
+  fOut -> cd();
+  return;
+
+}  // end 'MakePlotsInParallel(Bool_t[], Int_t[][], TString[], TString[])'
+
+
+
 void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDraw[], const TString sDirToSaveTo, const TString sPlotLabel) {
 
   // check if saving directory is made, if so, recurse into it
@@ -132,7 +284,16 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
   leg -> SetLineStyle(fLinL);
   leg -> SetTextFont(fTxtL);
   for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
-    leg -> AddEntry(hTrkVar[typesToDraw[iToDraw]][0], sTrkLabels[typesToDraw[iToDraw]].Data(), "pf");
+
+    // style entries by type so they don't depend on which histograms are loaded
+    const Int_t   iType = typesToDraw[iToDraw];
+    TLegendEntry *entry = leg -> AddEntry((TObject*) 0, sTrkLabels[iType].Data(), "pf");
+    entry -> SetMarkerColor(fTypeCol[iType]);
+    entry -> SetMarkerStyle(fTypeMar[iType]);
+    entry -> SetLineColor(fTypeCol[iType]);
+    entry -> SetLineStyle(fLinL);
+    entry -> SetFillColor(fTypeCol[iType]);
+    entry -> SetFillStyle(fFilL);
   }
 
   // determine what to text to add to box
@@ -197,6 +358,17 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
   const Float_t padXY[NPanel][NVtx]        = {{0., 0., 0.5, 1.}, {0.5, 0., 1., 1.}};
   const TString sOneVsTwoDimPanels[NPanel] = {"pOneDim", "pTwoDim"};
 
+  // legend, text box and canvas style feed the plot hash too
+  TString sPlotStyle = TString::Format("%u,%u,%u,%u;%u,%u,%u,%u,%u;%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u;%g,%g,%g,%g,%g",
+    fTxtL, fColL, fLinL, fFilL,
+    fTxtT, fAlnT, fColT, fLinT, fFilT,
+    fWidth1P, fWidth2P, fHeight1P, fHeight2P, fMode, fBord, fGrid, fTick, fLogX, fLogY, fLogZ, fFrame,
+    fMarginL, fMarginR1, fMarginR2, fMarginT, fMarginB
+  );
+  for (Ssiz_t iVtx = 0; iVtx < NVtx; iVtx++) {
+    sPlotStyle += TString::Format(";%g,%g,%g,%g", xyLeg[iVtx], xyTxt[iVtx], padXY[0][iVtx], padXY[1][iVtx]);
+  }
+
   // form canvas names
   const TString sDiffSuffix("Diff");
   const TString sFracSuffix("Frac");
@@ -206,6 +378,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
   const TString sVsPtRecoSuffix("VsPtReco");
   const TString sVsPtTrueSuffix("VsPtTrue");
   const TString sVsPtFracSuffix("VsPtFrac");
+  const TString sVsMultSuffix("VsMult");
 
   // for track-variable canvas names
   TString sTrkVar[NTrkVar];
@@ -217,6 +390,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
   TString sTrkVarVsPtReco[NTrkVar];
   TString sTrkVarVsPtTrue[NTrkVar];
   TString sTrkVarVsPtFrac[NTrkVar];
+  TString sTrkVarVsMult[NTrkVar];
 
   // for physics-variable canvas names
   TString sPhysVar[NPhysVar];
@@ -228,6 +402,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
   TString sPhysVarVsPtReco[NPhysVar];
   TString sPhysVarVsPtTrue[NPhysVar];
   TString sPhysVarVsPtFrac[NPhysVar];
+  TString sPhysVarVsMult[NPhysVar];
 
   // construct variable prefixes
   TString sTrkVarName[NTrkVar];
@@ -251,6 +426,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     sTrkVarVsPtReco[iTrkVar] = sTrkVarName[iTrkVar].Data();
     sTrkVarVsPtTrue[iTrkVar] = sTrkVarName[iTrkVar].Data();
     sTrkVarVsPtFrac[iTrkVar] = sTrkVarName[iTrkVar].Data();
+    sTrkVarVsMult[iTrkVar]   = sTrkVarName[iTrkVar].Data();
     sTrkVarDiff[iTrkVar].Append(sDiffSuffix.Data());
     sTrkVarFrac[iTrkVar].Append(sFracSuffix.Data());
     sTrkVarVsNTpc[iTrkVar].Append(sVsNTpcSuffix.Data());
@@ -259,6 +435,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     sTrkVarVsPtReco[iTrkVar].Append(sVsPtRecoSuffix.Data());
     sTrkVarVsPtTrue[iTrkVar].Append(sVsPtTrueSuffix.Data());
     sTrkVarVsPtFrac[iTrkVar].Append(sVsPtFracSuffix.Data());
+    sTrkVarVsMult[iTrkVar].Append(sVsMultSuffix.Data());
     sTrkVar[iTrkVar].Append("_");
     sTrkVarDiff[iTrkVar].Append("_");
     sTrkVarFrac[iTrkVar].Append("_");
@@ -268,6 +445,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     sTrkVarVsPtReco[iTrkVar].Append("_");
     sTrkVarVsPtTrue[iTrkVar].Append("_");
     sTrkVarVsPtFrac[iTrkVar].Append("_");
+    sTrkVarVsMult[iTrkVar].Append("_");
     sTrkVar[iTrkVar].Append(sPlotLabel.Data());
     sTrkVarDiff[iTrkVar].Append(sPlotLabel.Data());
     sTrkVarFrac[iTrkVar].Append(sPlotLabel.Data());
@@ -277,6 +455,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     sTrkVarVsPtReco[iTrkVar].Append(sPlotLabel.Data());
     sTrkVarVsPtTrue[iTrkVar].Append(sPlotLabel.Data());
     sTrkVarVsPtFrac[iTrkVar].Append(sPlotLabel.Data());
+    sTrkVarVsMult[iTrkVar].Append(sPlotLabel.Data());
   }
   for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
     sPhysVar[iPhysVar]         = sPhysVarName[iPhysVar].Data();
@@ -288,6 +467,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     sPhysVarVsPtReco[iPhysVar] = sPhysVarName[iPhysVar].Data();
     sPhysVarVsPtTrue[iPhysVar] = sPhysVarName[iPhysVar].Data();
     sPhysVarVsPtFrac[iPhysVar] = sPhysVarName[iPhysVar].Data();
+    sPhysVarVsMult[iPhysVar]   = sPhysVarName[iPhysVar].Data();
     sPhysVarDiff[iPhysVar].Append(sDiffSuffix.Data());
     sPhysVarFrac[iPhysVar].Append(sFracSuffix.Data());
     sPhysVarVsNTpc[iPhysVar].Append(sVsNTpcSuffix.Data());
@@ -296,6 +476,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     sPhysVarVsPtReco[iPhysVar].Append(sVsPtRecoSuffix.Data());
     sPhysVarVsPtTrue[iPhysVar].Append(sVsPtTrueSuffix.Data());
     sPhysVarVsPtFrac[iPhysVar].Append(sVsPtFracSuffix.Data());
+    sPhysVarVsMult[iPhysVar].Append(sVsMultSuffix.Data());
     sPhysVar[iPhysVar].Append("_");
     sPhysVarDiff[iPhysVar].Append("_");
     sPhysVarFrac[iPhysVar].Append("_");
@@ -305,6 +486,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     sPhysVarVsPtReco[iPhysVar].Append("_");
     sPhysVarVsPtTrue[iPhysVar].Append("_");
     sPhysVarVsPtFrac[iPhysVar].Append("_");
+    sPhysVarVsMult[iPhysVar].Append("_");
     sPhysVar[iPhysVar].Append(sPlotLabel.Data());
     sPhysVarDiff[iPhysVar].Append(sPlotLabel.Data());
     sPhysVarFrac[iPhysVar].Append(sPlotLabel.Data());
@@ -314,6 +496,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     sPhysVarVsPtReco[iPhysVar].Append(sPlotLabel.Data());
     sPhysVarVsPtTrue[iPhysVar].Append(sPlotLabel.Data());
     sPhysVarVsPtFrac[iPhysVar].Append(sPlotLabel.Data());
+    sPhysVarVsMult[iPhysVar].Append(sPlotLabel.Data());
   }
 
   // for track-variable plots
@@ -326,14 +509,29 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
   TCanvas *cTrkVarVsPtReco[NTrkVar];
   TCanvas *cTrkVarVsPtTrue[NTrkVar];
   TCanvas *cTrkVarVsPtFrac[NTrkVar];
+  TCanvas *cTrkVarVsMult[NTrkVar];
   TPad    *pTrkVarVsNTpc[NTrkVar][NPanel];
   TPad    *pTrkVarVsDcaXY[NTrkVar][NPanel];
   TPad    *pTrkVarVsDcaZ[NTrkVar][NPanel];
   TPad    *pTrkVarVsPtReco[NTrkVar][NPanel];
   TPad    *pTrkVarVsPtTrue[NTrkVar][NPanel];
   TPad    *pTrkVarVsPtFrac[NTrkVar][NPanel];
+  TPad    *pTrkVarVsMult[NTrkVar][NPanel];
   for (size_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
 
+    // skip variables handled elsewhere (e.g. by another plot worker)
+    if (!doTrkVarPlot[iTrkVar]) continue;
+
+    // load histograms for this variable (plot-only mode)
+    if (doPlotOnly) LoadVarHists(nToDraw, typesToDraw, iTrkVar, true);
+
+    // reuse canvases from the previous output if nothing feeding them changed
+    const TString sTrkHash = GetPlotHash(nToDraw, typesToDraw, iTrkVar, true, sPlotLabel, sPlotStyle);
+    if (CopyPreviousPlots(sDirToSaveTo, sTrkVars[iTrkVar], sPlotLabel, sTrkHash)) {
+      if (doPlotOnly) ReleaseVarHists(nToDraw, typesToDraw, iTrkVar, true);
+      continue;
+    }
+
     // 1d track variable
     cTrkVar[iTrkVar] = new TCanvas(sTrkVar[iTrkVar].Data(), "", fWidth1P, fHeight1P);
     cTrkVar[iTrkVar] -> SetGrid(fGrid, fGrid);
@@ -359,8 +557,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     leg              -> Draw();
     ptTxt            -> Draw();
     ptCut            -> Draw();
-    cTrkVar[iTrkVar] -> Write();
-    cTrkVar[iTrkVar] -> Close();
+    SaveCanvas(cTrkVar[iTrkVar], sDirToSaveTo);
 
     // 1d track difference
     cTrkVarDiff[iTrkVar] = new TCanvas(sTrkVarDiff[iTrkVar].Data(), "", fWidth1P, fHeight1P);
@@ -387,8 +584,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     leg                  -> Draw();
     ptTxt                -> Draw();
     ptCut                -> Draw();
-    cTrkVarDiff[iTrkVar] -> Write();
-    cTrkVarDiff[iTrkVar] -> Close();
+    SaveCanvas(cTrkVarDiff[iTrkVar], sDirToSaveTo);
 
     // 1d track fraction
     cTrkVarFrac[iTrkVar] = new TCanvas(sTrkVarFrac[iTrkVar].Data(), "", fWidth1P, fHeight1P);
@@ -415,8 +611,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     leg                  -> Draw();
     ptTxt                -> Draw();
     ptCut                -> Draw();
-    cTrkVarFrac[iTrkVar] -> Write();
-    cTrkVarFrac[iTrkVar] -> Close();
+    SaveCanvas(cTrkVarFrac[iTrkVar], sDirToSaveTo);
 
     // 2d track variables vs. ntpc
     cTrkVarVsNTpc[iTrkVar]    = new TCanvas(sTrkVarVsNTpc[iTrkVar].Data(), "", fWidth2P, fHeight2P);
@@ -467,13 +662,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pTrkVarVsNTpc[iTrkVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hTrkVarVsNTpc[typesToDraw[iToDraw]][iTrkVar] -> Draw("colz");
+        DrawReducedHist(hTrkVarVsNTpc[typesToDraw[iToDraw]][iTrkVar], "colz");
       } else {
-        hTrkVarVsNTpc[typesToDraw[iToDraw]][iTrkVar] -> Draw("scat same");
+        DrawReducedHist(hTrkVarVsNTpc[typesToDraw[iToDraw]][iTrkVar], "scat same");
       }
     }  // end to-draw loop
-    cTrkVarVsNTpc[iTrkVar] -> Write();
-    cTrkVarVsNTpc[iTrkVar] -> Close();
+    SaveCanvas(cTrkVarVsNTpc[iTrkVar], sDirToSaveTo);
 
     // 2d track variables vs. dcaxy
     cTrkVarVsDcaXY[iTrkVar]    = new TCanvas(sTrkVarVsDcaXY[iTrkVar].Data(), "", fWidth2P, fHeight2P);
@@ -524,13 +718,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pTrkVarVsDcaXY[iTrkVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hTrkVarVsDcaXY[typesToDraw[iToDraw]][iTrkVar] -> Draw("colz");
+        DrawReducedHist(hTrkVarVsDcaXY[typesToDraw[iToDraw]][iTrkVar], "colz");
       } else {
-        hTrkVarVsDcaXY[typesToDraw[iToDraw]][iTrkVar] -> Draw("scat same");
+        DrawReducedHist(hTrkVarVsDcaXY[typesToDraw[iToDraw]][iTrkVar], "scat same");
       }
     }  // end to-draw loop
-    cTrkVarVsDcaXY[iTrkVar] -> Write();
-    cTrkVarVsDcaXY[iTrkVar] -> Close();
+    SaveCanvas(cTrkVarVsDcaXY[iTrkVar], sDirToSaveTo);
 
     // 2d track variables vs. dcaz
     cTrkVarVsDcaZ[iTrkVar]    = new TCanvas(sTrkVarVsDcaZ[iTrkVar].Data(), "", fWidth2P, fHeight2P);
@@ -581,13 +774,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pTrkVarVsDcaZ[iTrkVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hTrkVarVsDcaZ[typesToDraw[iToDraw]][iTrkVar] -> Draw("colz");
+        DrawReducedHist(hTrkVarVsDcaZ[typesToDraw[iToDraw]][iTrkVar], "colz");
       } else {
-        hTrkVarVsDcaZ[typesToDraw[iToDraw]][iTrkVar] -> Draw("scat same");
+        DrawReducedHist(hTrkVarVsDcaZ[typesToDraw[iToDraw]][iTrkVar], "scat same");
       }
     }  // end to-draw loop
-    cTrkVarVsDcaZ[iTrkVar] -> Write();
-    cTrkVarVsDcaZ[iTrkVar] -> Close();
+    SaveCanvas(cTrkVarVsDcaZ[iTrkVar], sDirToSaveTo);
 
     // 2d track variables vs. ptreco
     cTrkVarVsPtReco[iTrkVar]    = new TCanvas(sTrkVarVsPtReco[iTrkVar].Data(), "", fWidth2P, fHeight2P);
@@ -638,13 +830,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pTrkVarVsPtReco[iTrkVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hTrkVarVsPtReco[typesToDraw[iToDraw]][iTrkVar] -> Draw("colz");
+        DrawReducedHist(hTrkVarVsPtReco[typesToDraw[iToDraw]][iTrkVar], "colz");
       } else {
-        hTrkVarVsPtReco[typesToDraw[iToDraw]][iTrkVar] -> Draw("scat same");
+        DrawReducedHist(hTrkVarVsPtReco[typesToDraw[iToDraw]][iTrkVar], "scat same");
       }
     }  // end to-draw loop
-    cTrkVarVsPtReco[iTrkVar] -> Write();
-    cTrkVarVsPtReco[iTrkVar] -> Close();
+    SaveCanvas(cTrkVarVsPtReco[iTrkVar], sDirToSaveTo);
 
     // 2d track variables vs. pttrue
     cTrkVarVsPtTrue[iTrkVar]    = new TCanvas(sTrkVarVsPtTrue[iTrkVar].Data(), "", fWidth2P, fHeight2P);
@@ -695,13 +886,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pTrkVarVsPtTrue[iTrkVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hTrkVarVsPtTrue[typesToDraw[iToDraw]][iTrkVar] -> Draw("colz");
+        DrawReducedHist(hTrkVarVsPtTrue[typesToDraw[iToDraw]][iTrkVar], "colz");
       } else {
-        hTrkVarVsPtTrue[typesToDraw[iToDraw]][iTrkVar] -> Draw("scat same");
+        DrawReducedHist(hTrkVarVsPtTrue[typesToDraw[iToDraw]][iTrkVar], "scat same");
       }
     }  // end to-draw loop
-    cTrkVarVsPtTrue[iTrkVar] -> Write();
-    cTrkVarVsPtTrue[iTrkVar] -> Close();
+    SaveCanvas(cTrkVarVsPtTrue[iTrkVar], sDirToSaveTo);
 
     // 2d track variables vs. pttrue
     cTrkVarVsPtFrac[iTrkVar]    = new TCanvas(sTrkVarVsPtFrac[iTrkVar].Data(), "", fWidth2P, fHeight2P);
@@ -752,13 +942,77 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pTrkVarVsPtFrac[iTrkVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hTrkVarVsPtFrac[typesToDraw[iToDraw]][iTrkVar] -> Draw("colz");
+        DrawReducedHist(hTrkVarVsPtFrac[typesToDraw[iToDraw]][iTrkVar], "colz");
       } else {
-        hTrkVarVsPtFrac[typesToDraw[iToDraw]][iTrkVar] -> Draw("scat same");
+        DrawReducedHist(hTrkVarVsPtFrac[typesToDraw[iToDraw]][iTrkVar], "scat same");
       }
     }  // end to-draw loop
-    cTrkVarVsPtFrac[iTrkVar] -> Write();
-    cTrkVarVsPtFrac[iTrkVar] -> Close();
+    SaveCanvas(cTrkVarVsPtFrac[iTrkVar], sDirToSaveTo);
+
+    // 2d track variables vs. event multiplicity (only booked with event grouping)
+    if (doEventGroups) {
+      cTrkVarVsMult[iTrkVar]    = new TCanvas(sTrkVarVsMult[iTrkVar].Data(), "", fWidth2P, fHeight2P);
+      pTrkVarVsMult[iTrkVar][0] = new TPad(sOneVsTwoDimPanels[0].Data(), "", padXY[0][0], padXY[0][1], padXY[0][2], padXY[0][3]);
+      pTrkVarVsMult[iTrkVar][1] = new TPad(sOneVsTwoDimPanels[1].Data(), "", padXY[1][0], padXY[1][1], padXY[1][2], padXY[1][3]);
+      cTrkVarVsMult[iTrkVar]    -> SetGrid(fGrid, fGrid);
+      cTrkVarVsMult[iTrkVar]    -> SetTicks(fTick, fTick);
+      cTrkVarVsMult[iTrkVar]    -> SetBorderMode(fMode);
+      cTrkVarVsMult[iTrkVar]    -> SetBorderSize(fBord);
+      pTrkVarVsMult[iTrkVar][0] -> SetGrid(fGrid, fGrid);
+      pTrkVarVsMult[iTrkVar][0] -> SetTicks(fTick, fTick);
+      pTrkVarVsMult[iTrkVar][0] -> SetLogx(fLogX);
+      pTrkVarVsMult[iTrkVar][0] -> SetLogy(fLogY);
+      pTrkVarVsMult[iTrkVar][0] -> SetLogz(fLogZ);
+      pTrkVarVsMult[iTrkVar][0] -> SetBorderMode(fMode);
+      pTrkVarVsMult[iTrkVar][0] -> SetBorderSize(fBord);
+      pTrkVarVsMult[iTrkVar][0] -> SetFrameBorderMode(fFrame);
+      pTrkVarVsMult[iTrkVar][0] -> SetLeftMargin(fMarginL);
+      pTrkVarVsMult[iTrkVar][0] -> SetRightMargin(fMarginR1);
+      pTrkVarVsMult[iTrkVar][0] -> SetTopMargin(fMarginT);
+      pTrkVarVsMult[iTrkVar][0] -> SetBottomMargin(fMarginB);
+      pTrkVarVsMult[iTrkVar][1] -> SetGrid(fGrid, fGrid);
+      pTrkVarVsMult[iTrkVar][1] -> SetTicks(fTick, fTick);
+      pTrkVarVsMult[iTrkVar][1] -> SetLogx(fLogX);
+      pTrkVarVsMult[iTrkVar][1] -> SetLogy(fLogY);
+      pTrkVarVsMult[iTrkVar][1] -> SetLogz(fLogZ);
+      pTrkVarVsMult[iTrkVar][1] -> SetBorderMode(fMode);
+      pTrkVarVsMult[iTrkVar][1] -> SetBorderSize(fBord);
+      pTrkVarVsMult[iTrkVar][1] -> SetFrameBorderMode(fFrame);
+      pTrkVarVsMult[iTrkVar][1] -> SetLeftMargin(fMarginL);
+      pTrkVarVsMult[iTrkVar][1] -> SetRightMargin(fMarginR2);
+      pTrkVarVsMult[iTrkVar][1] -> SetTopMargin(fMarginT);
+      pTrkVarVsMult[iTrkVar][1] -> SetBottomMargin(fMarginB);
+      cTrkVarVsMult[iTrkVar]    -> cd();
+      pTrkVarVsMult[iTrkVar][0] -> Draw();
+      pTrkVarVsMult[iTrkVar][1] -> Draw();
+      pTrkVarVsMult[iTrkVar][0] -> cd();
+      for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
+        if (iToDraw == 0) {
+          hTrkVar[typesToDraw[iToDraw]][iTrkVar] -> Draw();
+        } else {
+          hTrkVar[typesToDraw[iToDraw]][iTrkVar] -> Draw("same");
+        }
+      }  // end to-draw loop
+      leg                       -> Draw();
+      ptTxt                     -> Draw();
+      ptCut                     -> Draw();
+      pTrkVarVsMult[iTrkVar][1] -> cd();
+      for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
+        if (iToDraw == 0) {
+          DrawReducedHist(hTrkVarVsMult[typesToDraw[iToDraw]][iTrkVar], "colz");
+        } else {
+          DrawReducedHist(hTrkVarVsMult[typesToDraw[iToDraw]][iTrkVar], "scat same");
+        }
+      }  // end to-draw loop
+      SaveCanvas(cTrkVarVsMult[iTrkVar], sDirToSaveTo);
+    }
+
+    // remember what these plots were made from
+    TNamed nTrkHash(("md5_" + sTrkVars[iTrkVar]).Data(), sTrkHash.Data());
+    fOut -> GetDirectory(sDirToSaveTo.Data()) -> WriteTObject(&nTrkHash);
+
+    // and release them once drawn
+    if (doPlotOnly) ReleaseVarHists(nToDraw, typesToDraw, iTrkVar, true);
   }  // end track variable loop
 
   // for physics-variable plots
@@ -771,14 +1025,29 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
   TCanvas *cPhysVarVsPtReco[NPhysVar];
   TCanvas *cPhysVarVsPtTrue[NPhysVar];
   TCanvas *cPhysVarVsPtFrac[NPhysVar];
+  TCanvas *cPhysVarVsMult[NPhysVar];
   TPad    *pPhysVarVsNTpc[NPhysVar][NPanel];
   TPad    *pPhysVarVsDcaXY[NPhysVar][NPanel];
   TPad    *pPhysVarVsDcaZ[NPhysVar][NPanel];
   TPad    *pPhysVarVsPtReco[NPhysVar][NPanel];
   TPad    *pPhysVarVsPtTrue[NPhysVar][NPanel];
   TPad    *pPhysVarVsPtFrac[NPhysVar][NPanel];
+  TPad    *pPhysVarVsMult[NPhysVar][NPanel];
   for (size_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
 
+    // skip variables handled elsewhere (e.g. by another plot worker)
+    if (!doPhysVarPlot[iPhysVar]) continue;
+
+    // load histograms for this variable (plot-only mode)
+    if (doPlotOnly) LoadVarHists(nToDraw, typesToDraw, iPhysVar, false);
+
+    // reuse canvases from the previous output if nothing feeding them changed
+    const TString sPhysHash = GetPlotHash(nToDraw, typesToDraw, iPhysVar, false, sPlotLabel, sPlotStyle);
+    if (CopyPreviousPlots(sDirToSaveTo, sPhysVars[iPhysVar], sPlotLabel, sPhysHash)) {
+      if (doPlotOnly) ReleaseVarHists(nToDraw, typesToDraw, iPhysVar, false);
+      continue;
+    }
+
     // 1d physics variable
     cPhysVar[iPhysVar] = new TCanvas(sPhysVar[iPhysVar].Data(), "", fWidth1P, fHeight1P);
     cPhysVar[iPhysVar] -> SetGrid(fGrid, fGrid);
@@ -804,8 +1073,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     leg                -> Draw();
     ptTxt              -> Draw();
     ptCut              -> Draw();
-    cPhysVar[iPhysVar] -> Write();
-    cPhysVar[iPhysVar] -> Close();
+    SaveCanvas(cPhysVar[iPhysVar], sDirToSaveTo);
 
     // 1d physics difference
     cPhysVarDiff[iPhysVar] = new TCanvas(sPhysVarDiff[iPhysVar].Data(), "", fWidth1P, fHeight1P);
@@ -832,8 +1100,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     leg                    -> Draw();
     ptTxt                  -> Draw();
     ptCut                  -> Draw();
-    cPhysVarDiff[iPhysVar] -> Write();
-    cPhysVarDiff[iPhysVar] -> Close();
+    SaveCanvas(cPhysVarDiff[iPhysVar], sDirToSaveTo);
 
     // 1d physics fraction
     cPhysVarFrac[iPhysVar] = new TCanvas(sPhysVarFrac[iPhysVar].Data(), "", fWidth1P, fHeight1P);
@@ -860,8 +1127,7 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     leg                    -> Draw();
     ptTxt                  -> Draw();
     ptCut                  -> Draw();
-    cPhysVarFrac[iPhysVar] -> Write();
-    cPhysVarFrac[iPhysVar] -> Close();
+    SaveCanvas(cPhysVarFrac[iPhysVar], sDirToSaveTo);
 
     // 2d physics variables vs. ntpc
     cPhysVarVsNTpc[iPhysVar]    = new TCanvas(sPhysVarVsNTpc[iPhysVar].Data(), "", fWidth2P, fHeight2P);
@@ -912,13 +1178,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pPhysVarVsNTpc[iPhysVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hPhysVarVsNTpc[typesToDraw[iToDraw]][iPhysVar] -> Draw("colz");
+        DrawReducedHist(hPhysVarVsNTpc[typesToDraw[iToDraw]][iPhysVar], "colz");
       } else {
-        hPhysVarVsNTpc[typesToDraw[iToDraw]][iPhysVar] -> Draw("scat same");
+        DrawReducedHist(hPhysVarVsNTpc[typesToDraw[iToDraw]][iPhysVar], "scat same");
       }
     }  // end to-draw loop
-    cPhysVarVsNTpc[iPhysVar] -> Write();
-    cPhysVarVsNTpc[iPhysVar] -> Close();
+    SaveCanvas(cPhysVarVsNTpc[iPhysVar], sDirToSaveTo);
 
     // 2d physics variables vs. dcaxy
     cPhysVarVsDcaXY[iPhysVar]    = new TCanvas(sPhysVarVsDcaXY[iPhysVar].Data(), "", fWidth2P, fHeight2P);
@@ -969,13 +1234,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pPhysVarVsDcaXY[iPhysVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hPhysVarVsDcaXY[typesToDraw[iToDraw]][iPhysVar] -> Draw("colz");
+        DrawReducedHist(hPhysVarVsDcaXY[typesToDraw[iToDraw]][iPhysVar], "colz");
       } else {
-        hPhysVarVsDcaXY[typesToDraw[iToDraw]][iPhysVar] -> Draw("scat same");
+        DrawReducedHist(hPhysVarVsDcaXY[typesToDraw[iToDraw]][iPhysVar], "scat same");
       }
     }  // end to-draw loop
-    cPhysVarVsDcaXY[iPhysVar] -> Write();
-    cPhysVarVsDcaXY[iPhysVar] -> Close();
+    SaveCanvas(cPhysVarVsDcaXY[iPhysVar], sDirToSaveTo);
 
     // 2d physics variables vs. dcaz
     cPhysVarVsDcaZ[iPhysVar]    = new TCanvas(sPhysVarVsDcaZ[iPhysVar].Data(), "", fWidth2P, fHeight2P);
@@ -1026,13 +1290,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pPhysVarVsDcaZ[iPhysVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hPhysVarVsDcaZ[typesToDraw[iToDraw]][iPhysVar] -> Draw("colz");
+        DrawReducedHist(hPhysVarVsDcaZ[typesToDraw[iToDraw]][iPhysVar], "colz");
       } else {
-        hPhysVarVsDcaZ[typesToDraw[iToDraw]][iPhysVar] -> Draw("scat same");
+        DrawReducedHist(hPhysVarVsDcaZ[typesToDraw[iToDraw]][iPhysVar], "scat same");
       }
     }  // end to-draw loop
-    cPhysVarVsDcaZ[iPhysVar] -> Write();
-    cPhysVarVsDcaZ[iPhysVar] -> Close();
+    SaveCanvas(cPhysVarVsDcaZ[iPhysVar], sDirToSaveTo);
 
     // 2d physics variables vs. ptreco
     cPhysVarVsPtReco[iPhysVar]    = new TCanvas(sPhysVarVsPtReco[iPhysVar].Data(), "", fWidth2P, fHeight2P);
@@ -1083,13 +1346,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pPhysVarVsPtReco[iPhysVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hPhysVarVsPtReco[typesToDraw[iToDraw]][iPhysVar] -> Draw("colz");
+        DrawReducedHist(hPhysVarVsPtReco[typesToDraw[iToDraw]][iPhysVar], "colz");
       } else {
-        hPhysVarVsPtReco[typesToDraw[iToDraw]][iPhysVar] -> Draw("scat same");
+        DrawReducedHist(hPhysVarVsPtReco[typesToDraw[iToDraw]][iPhysVar], "scat same");
       }
     }  // end to-draw loop
-    cPhysVarVsPtReco[iPhysVar] -> Write();
-    cPhysVarVsPtReco[iPhysVar] -> Close();
+    SaveCanvas(cPhysVarVsPtReco[iPhysVar], sDirToSaveTo);
 
     // 2d physics variables vs. pttrue
     cPhysVarVsPtTrue[iPhysVar]    = new TCanvas(sPhysVarVsPtTrue[iPhysVar].Data(), "", fWidth2P, fHeight2P);
@@ -1140,13 +1402,12 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pPhysVarVsPtTrue[iPhysVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hPhysVarVsPtTrue[typesToDraw[iToDraw]][iPhysVar] -> Draw("colz");
+        DrawReducedHist(hPhysVarVsPtTrue[typesToDraw[iToDraw]][iPhysVar], "colz");
       } else {
-        hPhysVarVsPtTrue[typesToDraw[iToDraw]][iPhysVar] -> Draw("scat same");
+        DrawReducedHist(hPhysVarVsPtTrue[typesToDraw[iToDraw]][iPhysVar], "scat same");
       }
     }  // end to-draw loop
-    cPhysVarVsPtTrue[iPhysVar] -> Write();
-    cPhysVarVsPtTrue[iPhysVar] -> Close();
+    SaveCanvas(cPhysVarVsPtTrue[iPhysVar], sDirToSaveTo);
 
     // 2d physics variables vs. pttrue
     cPhysVarVsPtFrac[iPhysVar]    = new TCanvas(sPhysVarVsPtFrac[iPhysVar].Data(), "", fWidth2P, fHeight2P);
@@ -1197,13 +1458,77 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
     pPhysVarVsPtFrac[iPhysVar][1] -> cd();
     for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
       if (iToDraw == 0) {
-        hPhysVarVsPtFrac[typesToDraw[iToDraw]][iPhysVar] -> Draw("colz");
+        DrawReducedHist(hPhysVarVsPtFrac[typesToDraw[iToDraw]][iPhysVar], "colz");
       } else {
-        hPhysVarVsPtFrac[typesToDraw[iToDraw]][iPhysVar] -> Draw("scat same");
+        DrawReducedHist(hPhysVarVsPtFrac[typesToDraw[iToDraw]][iPhysVar], "scat same");
       }
     }  // end to-draw loop
-    cPhysVarVsPtFrac[iPhysVar] -> Write();
-    cPhysVarVsPtFrac[iPhysVar] -> Close();
+    SaveCanvas(cPhysVarVsPtFrac[iPhysVar], sDirToSaveTo);
+
+    // 2d physics variables vs. event multiplicity (only booked with event grouping)
+    if (doEventGroups) {
+      cPhysVarVsMult[iPhysVar]    = new TCanvas(sPhysVarVsMult[iPhysVar].Data(), "", fWidth2P, fHeight2P);
+      pPhysVarVsMult[iPhysVar][0] = new TPad(sOneVsTwoDimPanels[0].Data(), "", padXY[0][0], padXY[0][1], padXY[0][2], padXY[0][3]);
+      pPhysVarVsMult[iPhysVar][1] = new TPad(sOneVsTwoDimPanels[1].Data(), "", padXY[1][0], padXY[1][1], padXY[1][2], padXY[1][3]);
+      cPhysVarVsMult[iPhysVar]    -> SetGrid(fGrid, fGrid);
+      cPhysVarVsMult[iPhysVar]    -> SetTicks(fTick, fTick);
+      cPhysVarVsMult[iPhysVar]    -> SetBorderMode(fMode);
+      cPhysVarVsMult[iPhysVar]    -> SetBorderSize(fBord);
+      pPhysVarVsMult[iPhysVar][0] -> SetGrid(fGrid, fGrid);
+      pPhysVarVsMult[iPhysVar][0] -> SetTicks(fTick, fTick);
+      pPhysVarVsMult[iPhysVar][0] -> SetLogx(fLogX);
+      pPhysVarVsMult[iPhysVar][0] -> SetLogy(fLogY);
+      pPhysVarVsMult[iPhysVar][0] -> SetLogz(fLogZ);
+      pPhysVarVsMult[iPhysVar][0] -> SetBorderMode(fMode);
+      pPhysVarVsMult[iPhysVar][0] -> SetBorderSize(fBord);
+      pPhysVarVsMult[iPhysVar][0] -> SetFrameBorderMode(fFrame);
+      pPhysVarVsMult[iPhysVar][0] -> SetLeftMargin(fMarginL);
+      pPhysVarVsMult[iPhysVar][0] -> SetRightMargin(fMarginR1);
+      pPhysVarVsMult[iPhysVar][0] -> SetTopMargin(fMarginT);
+      pPhysVarVsMult[iPhysVar][0] -> SetBottomMargin(fMarginB);
+      pPhysVarVsMult[iPhysVar][1] -> SetGrid(fGrid, fGrid);
+      pPhysVarVsMult[iPhysVar][1] -> SetTicks(fTick, fTick);
+      pPhysVarVsMult[iPhysVar][1] -> SetLogx(fLogX);
+      pPhysVarVsMult[iPhysVar][1] -> SetLogy(fLogY);
+      pPhysVarVsMult[iPhysVar][1] -> SetLogz(fLogZ);
+      pPhysVarVsMult[iPhysVar][1] -> SetBorderMode(fMode);
+      pPhysVarVsMult[iPhysVar][1] -> SetBorderSize(fBord);
+      pPhysVarVsMult[iPhysVar][1] -> SetFrameBorderMode(fFrame);
+      pPhysVarVsMult[iPhysVar][1] -> SetLeftMargin(fMarginL);
+      pPhysVarVsMult[iPhysVar][1] -> SetRightMargin(fMarginR2);
+      pPhysVarVsMult[iPhysVar][1] -> SetTopMargin(fMarginT);
+      pPhysVarVsMult[iPhysVar][1] -> SetBottomMargin(fMarginB);
+      cPhysVarVsMult[iPhysVar]    -> cd();
+      pPhysVarVsMult[iPhysVar][0] -> Draw();
+      pPhysVarVsMult[iPhysVar][1] -> Draw();
+      pPhysVarVsMult[iPhysVar][0] -> cd();
+      for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
+        if (iToDraw == 0) {
+          hPhysVar[typesToDraw[iToDraw]][iPhysVar] -> Draw();
+        } else {
+          hPhysVar[typesToDraw[iToDraw]][iPhysVar] -> Draw("same");
+        }
+      }  // end to-draw loop
+      leg                         -> Draw();
+      ptTxt                       -> Draw();
+      ptCut                       -> Draw();
+      pPhysVarVsMult[iPhysVar][1] -> cd();
+      for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
+        if (iToDraw == 0) {
+          DrawReducedHist(hPhysVarVsMult[typesToDraw[iToDraw]][iPhysVar], "colz");
+        } else {
+          DrawReducedHist(hPhysVarVsMult[typesToDraw[iToDraw]][iPhysVar], "scat same");
+        }
+      }  // end to-draw loop
+      SaveCanvas(cPhysVarVsMult[iPhysVar], sDirToSaveTo);
+    }
+
+    // remember what these plots were made from
+    TNamed nPhysHash(("md5_" + sPhysVars[iPhysVar]).Data(), sPhysHash.Data());
+    fOut -> GetDirectory(sDirToSaveTo.Data()) -> WriteTObject(&nPhysHash);
+
+    // and release them once drawn
+    if (doPlotOnly) ReleaseVarHists(nToDraw, typesToDraw, iPhysVar, false);
   }  // end physics variable loop
 
   // return to top dir
@@ -1212,4 +1537,296 @@ void STrackCutStudy::ConstructPlots(const Ssiz_t nToDraw, const Int_t typesToDra
 
 }  // end 'ConstructPlots(Ssiz_t, Int_t[], TString, TString)'
 
+
+
+void STrackCutStudy::SaveCanvas(TCanvas *canvas, const TString sDirToSaveTo) {
+
+  canvas -> Write();
+  if (doImageExport) {
+    const TString sImage = sImageDir + "/" + sDirToSaveTo + "/" + canvas -> GetName();
+    canvas -> SaveAs((sImage + ".png").Data());
+    canvas -> SaveAs((sImage + ".pdf").Data());
+
+    // thumbnail for the index
+    TImage *thumb = TImage::Open((sImage + ".png").Data());
+    if (thumb) {
+      thumb -> Scale(FThumbWidth, (FThumbWidth * thumb -> GetHeight()) / thumb -> GetWidth());
+      thumb -> WriteImage((sImage + ".thumb.png").Data());
+      delete thumb;
+    }
+  }
+  canvas -> Close();
+  return;
+
+}  // end 'SaveCanvas(TCanvas*, TString)'
+
+
+
+void STrackCutStudy::DrawReducedHist(TH2D *hist, const TString sOption) {
+
+  // pixels covered by the current pad's frame
+  const Double_t xPixels = gPad -> GetWw() * gPad -> GetAbsWNDC() * (1. - gPad -> GetLeftMargin() - gPad -> GetRightMargin());
+  const Double_t yPixels = gPad -> GetWh() * gPad -> GetAbsHNDC() * (1. - gPad -> GetTopMargin() - gPad -> GetBottomMargin());
+
+  // scatter overlays don't need more than a coarse grid
+  const Bool_t isScat   = sOption.Contains("scat");
+  const Int_t  nMaxBinX = isScat ? TMath::Min((Int_t) xPixels, NMaxScatBins) : (Int_t) xPixels;
+  const Int_t  nMaxBinY = isScat ? TMath::Min((Int_t) yPixels, NMaxScatBins) : (Int_t) yPixels;
+  const Int_t  nGroupX  = GetRebinFactor(hist -> GetNbinsX(), nMaxBinX);
+  const Int_t  nGroupY  = GetRebinFactor(hist -> GetNbinsY(), nMaxBinY);
+  if ((nGroupX == 1) && (nGroupY == 1)) {
+    hist -> Draw(sOption.Data());
+    return;
+  }
+
+  // draw a reduced clone (full resolution stays in the type directories)
+  TH2D *hReduced = (TH2D*) hist -> Clone();
+  hReduced -> SetDirectory(0);
+  hReduced -> Rebin2D(nGroupX, nGroupY);
+  hReduced -> SetBit(kCanDelete);
+  hReduced -> Draw(sOption.Data());
+  return;
+
+}  // end 'DrawReducedHist(TH2D*, TString)'
+
+
+
+Int_t STrackCutStudy::GetRebinFactor(const Int_t nBins, const Int_t nMaxBins) {
+
+  if ((nMaxBins <= 0) || (nBins <= nMaxBins)) return 1;
+
+  // smallest divisor that gets under the limit, unless that's far
+  // coarser than needed (rebinning by a non-divisor moves the edge)
+  const Int_t nMinGroup = (nBins + nMaxBins - 1) / nMaxBins;
+  for (Int_t nGroup = nMinGroup; nGroup <= (2 * nMinGroup); nGroup++) {
+    if ((nBins % nGroup) == 0) return nGroup;
+  }
+  return 1;
+
+}  // end 'GetRebinFactor(Int_t, Int_t)'
+
+
+
+TString STrackCutStudy::GetPlotHash(const Ssiz_t nToDraw, const Int_t typesToDraw[], const Int_t iVar, const Bool_t isTrkVar, const TString sPlotLabel, const TString sPlotStyle) {
+
+  TMD5 md5;
+  for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
+    const Int_t iType = typesToDraw[iToDraw];
+
+    TH1 *hists[NPlotFam];
+    if (isTrkVar) {
+      hists[0] = hTrkVar[iType][iVar];
+      hists[1] = hTrkVarDiff[iType][iVar];
+      hists[2] = hTrkVarFrac[iType][iVar];
+      hists[3] = hTrkVarVsNTpc[iType][iVar];
+      hists[4] = hTrkVarVsDcaXY[iType][iVar];
+      hists[5] = hTrkVarVsDcaZ[iType][iVar];
+      hists[6] = hTrkVarVsPtReco[iType][iVar];
+      hists[7] = hTrkVarVsPtTrue[iType][iVar];
+      hists[8] = hTrkVarVsPtFrac[iType][iVar];
+      hists[9] = hTrkVarVsMult[iType][iVar];
+    } else {
+      hists[0] = hPhysVar[iType][iVar];
+      hists[1] = hPhysVarDiff[iType][iVar];
+      hists[2] = hPhysVarFrac[iType][iVar];
+      hists[3] = hPhysVarVsNTpc[iType][iVar];
+      hists[4] = hPhysVarVsDcaXY[iType][iVar];
+      hists[5] = hPhysVarVsDcaZ[iType][iVar];
+      hists[6] = hPhysVarVsPtReco[iType][iVar];
+      hists[7] = hPhysVarVsPtTrue[iType][iVar];
+      hists[8] = hPhysVarVsPtFrac[iType][iVar];
+      hists[9] = hPhysVarVsMult[iType][iVar];
+    }
+
+    // contents, errors, binning and style of each histogram
+    for (Ssiz_t iFam = 0; iFam < NPlotFam; iFam++) {
+      TH1 *hist = hists[iFam];
+      if (!hist) continue;
+
+      TArrayD *contents = dynamic_cast<TArrayD*>(hist);
+      if (contents) md5.Update((UChar_t*) contents -> GetArray(), contents -> GetSize() * sizeof(Double_t));
+      if (hist -> GetSumw2N() > 0) md5.Update((UChar_t*) hist -> GetSumw2() -> GetArray(), hist -> GetSumw2N() * sizeof(Double_t));
+
+      const TString sHist = TString::Format("%s;%s;%d,%g,%g;%d,%g,%g;%d,%d,%d,%d,%d",
+        hist -> GetName(),
+        hist -> GetTitle(),
+        hist -> GetNbinsX(),
+        hist -> GetXaxis() -> GetXmin(),
+        hist -> GetXaxis() -> GetXmax(),
+        hist -> GetNbinsY(),
+        hist -> GetYaxis() -> GetXmin(),
+        hist -> GetYaxis() -> GetXmax(),
+        hist -> GetLineColor(),
+        hist -> GetLineStyle(),
+        hist -> GetMarkerColor(),
+        hist -> GetMarkerStyle(),
+        hist -> GetFillStyle()
+      );
+      md5.Update((UChar_t*) sHist.Data(), sHist.Length());
+    }
+  }
+
+  // plot configuration: labels, style, text, cuts, and rendering limits
+  TString sConfig = sPlotLabel + ";" + sPlotStyle;
+  sConfig += TString::Format(";%d;%d;%u", doIntNorm, NMaxScatBins, FThumbWidth);
+  for (Ssiz_t iToDraw = 0; iToDraw < nToDraw; iToDraw++) {
+    sConfig += ";" + sTrkLabels[typesToDraw[iToDraw]];
+  }
+  for (const TString &sTxt : sTxtEO) sConfig += ";" + sTxt;
+  for (const TString &sTxt : sTxtPU) sConfig += ";" + sTxt;
+  if (ptCut) {
+    TIter nextLine(ptCut -> GetListOfLines());
+    while (TText *line = (TText*) nextLine()) {
+      sConfig += ";";
+      sConfig += line -> GetTitle();
+    }
+  }
+  md5.Update((UChar_t*) sConfig.Data(), sConfig.Length());
+  md5.Final();
+  return TString(md5.AsString());
+
+}  // end 'GetPlotHash(Ssiz_t, Int_t[], Int_t, Bool_t, TString, TString)'
+
+
+
+Bool_t STrackCutStudy::CopyPreviousPlots(const TString sDirToSaveTo, const TString sVar, const TString sPlotLabel, const TString sHash) {
+
+  if (!fPrevPlot) return false;
+
+  TDirectory *dPrev = fPrevPlot -> GetDirectory(sDirToSaveTo.Data());
+  if (!dPrev) return false;
+
+  TNamed *prevHash = (TNamed*) dPrev -> Get(("md5_" + sVar).Data());
+  if (!prevHash) return false;
+  if (sHash != prevHash -> GetTitle()) {
+    delete prevHash;
+    return false;
+  }
+
+  // every canvas (and image) has to still be there
+  vector<TObject*> plots;
+  for (Ssiz_t iFam = 0; iFam < NPlotFam; iFam++) {
+    if ((iFam == PLOTFAM::FAM_VSMULT) && !doEventGroups) continue;
+    const TString sPlot = "c" + sVar + sPlotFams[iFam] + "_" + sPlotLabel;
+    const TString sImage = sImageDir + "/" + sDirToSaveTo + "/" + sPlot;
+    const Bool_t isImageMissing = doImageExport && (gSystem -> AccessPathName((sImage + ".png").Data()) || gSystem -> AccessPathName((sImage + ".thumb.png").Data()));
+
+    TObject *plot = dPrev -> Get(sPlot.Data());
+    if (!plot || isImageMissing) {
+      for (TObject *copied : plots) delete copied;
+      delete prevHash;
+      return false;
+    }
+    plots.push_back(plot);
+  }
+
+  TDirectory *dOut = fOut -> GetDirectory(sDirToSaveTo.Data());
+  for (TObject *plot : plots) {
+    dOut -> WriteTObject(plot);
+    delete plot;
+  }
+  dOut -> WriteTObject(prevHash);
+  dOut -> cd();
+  delete prevHash;
+  return true;
+
+}  // end 'CopyPreviousPlots(TString, TString, TString, TString)'
+
+
+
+void STrackCutStudy::MakeCandidateRatios() {
+
+  // canvas parameters
+  const UInt_t  fWidth1P(750);
+  const UInt_t  fHeight1P(750);
+  const UInt_t  fTick(1);
+  const Float_t fMarginL(0.12);
+  const Float_t fMarginR(0.02);
+  const Float_t fMarginT(0.02);
+  const Float_t fMarginB(0.12);
+  const TString sRatioDir("CandidateRatios");
+
+  // ratios are candidate / baseline at each cut level
+  const Int_t  baseTypes[NCutLevel] = {TYPE::TRACK,     TYPE::TRK_CUT};
+  const Int_t  candTypes[NCutLevel] = {TYPE::CANDIDATE, TYPE::CAND_CUT};
+  const Bool_t isLevelOn[NCutLevel] = {doBeforeCuts,    true};
+
+  TDirectory *dRatio = fOut -> mkdir(sRatioDir.Data());
+  if (doImageExport) gSystem -> mkdir((sImageDir + "/" + sRatioDir).Data(), true);
+
+  for (Ssiz_t iLevel = 0; iLevel < NCutLevel; iLevel++) {
+    if (!isLevelOn[iLevel]) continue;
+
+    for (Ssiz_t iVar = 0; iVar < (NTrkVar + NPhysVar); iVar++) {
+      const Bool_t  isTrkVar = (iVar < NTrkVar);
+      const TString sVar     = isTrkVar ? sTrkVars[iVar] : sPhysVars[iVar - NTrkVar];
+      TH1D         *hBase    = isTrkVar ? hTrkVar[baseTypes[iLevel]][iVar] : hPhysVar[baseTypes[iLevel]][iVar - NTrkVar];
+      TH1D         *hCand    = isTrkVar ? hTrkVar[candTypes[iLevel]][iVar] : hPhysVar[candTypes[iLevel]][iVar - NTrkVar];
+
+      const TString sRatio = "hRatio" + sVar + "_" + sCutLevels[iLevel];
+      TH1D *hRatio = (TH1D*) hCand -> Clone(sRatio.Data());
+      hRatio -> Divide(hBase);
+      hRatio -> GetYaxis() -> SetTitle("candidate / baseline");
+
+      dRatio -> cd();
+      TCanvas *cRatio = new TCanvas(("cRatio" + sVar + "_" + sCutLevels[iLevel]).Data(), "", fWidth1P, fHeight1P);
+      cRatio -> SetTicks(fTick, fTick);
+      cRatio -> SetLeftMargin(fMarginL);
+      cRatio -> SetRightMargin(fMarginR);
+      cRatio -> SetTopMargin(fMarginT);
+      cRatio -> SetBottomMargin(fMarginB);
+      cRatio -> cd();
+      hRatio -> Draw();
+      ptCut  -> Draw();
+      SaveCanvas(cRatio, sRatioDir);
+      delete hRatio;
+    }
+  }
+  cout << "      Made candidate / baseline ratios." << endl;
+  return;
+
+}  // end 'MakeCandidateRatios()'
+
+
+
+void STrackCutStudy::WritePlotIndex(const Bool_t isGroupOn[], const TString sGroupDirs[], const TString sGroupLabels[]) {
+
+  // hashes go in the image urls, so browsers only reload what changed
+  const TString sIndex = sImageDir + "/index.html";
+  ofstream index(sIndex.Data());
+  index << "<!DOCTYPE html>\n"
+        << "<html>\n<head><title>Track cut study: " << sOutfile.Data() << "</title></head>\n<body>\n"
+        << "<h1>" << sOutfile.Data() << "</h1>\n";
+
+  for (Ssiz_t iGroup = 0; iGroup < NPlotGroup; iGroup++) {
+    if (!isGroupOn[iGroup]) continue;
+
+    TDirectory *dOut = fOut -> GetDirectory(sGroupDirs[iGroup].Data());
+    if (!dOut) continue;
+
+    index << "<h2>" << sGroupDirs[iGroup].Data() << "</h2>\n";
+    for (Ssiz_t iVar = 0; iVar < (NTrkVar + NPhysVar); iVar++) {
+      const TString sVar  = (iVar < NTrkVar) ? sTrkVars[iVar] : sPhysVars[iVar - NTrkVar];
+      TNamed       *hash  = (TNamed*) dOut -> Get(("md5_" + sVar).Data());
+      const TString sHash = hash ? hash -> GetTitle() : "";
+
+      index << "<h3>" << sVar.Data() << "</h3>\n<p>\n";
+      for (Ssiz_t iFam = 0; iFam < NPlotFam; iFam++) {
+        if ((iFam == PLOTFAM::FAM_VSMULT) && !doEventGroups) continue;
+        const TString sPlot = sGroupDirs[iGroup] + "/c" + sVar + sPlotFams[iFam] + "_" + sGroupLabels[iGroup];
+        index << "  <a href=\"" << sPlot.Data() << ".pdf\"><img src=\"" << sPlot.Data() << ".thumb.png?v=" << sHash.Data()
+              << "\" title=\"" << sPlot.Data() << "\"></a>\n";
+      }
+      index << "</p>\n";
+      if (hash) delete hash;
+    }
+  }
+  index << "</body>\n</html>\n";
+  index.close();
+
+  cout << "      Wrote plot index to '" << sIndex.Data() << "'." << endl;
+  return;
+
+}  // end 'WritePlotIndex(Bool_t[], TString[], TString[])'
+
 // end ------------------------------------------------------------------------
@@ -0,0 +1,331 @@
+// ----------------------------------------------------------------------------
+// 'STrackCutStudyBench.cc'
+// Derek Anderson
+// 10.18.2026
+//
+// Microbenchmarks for the hot kernels of the
+// 'STrackCutStudy' class: 'ApplyCuts()', the
+// track and truth histogram fills, and
+// 'NormalizeHists()' and 'SaveHists()'.
+// Each kernel is run on generated inputs (no
+// tuples needed) and reported in ns/track and
+// fills/s.  Fills are run for a varying number
+// of types and histogram families, with a hot
+// working set (one type, values in a handful
+// of bins) and a cold one (every type filled,
+// values spread over the full axes).
+//
+// Usage: strackcutstudybench [no. of tracks] [no. of save threads]
+// ----------------------------------------------------------------------------
+
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <TFile.h>
+#include <TError.h>
+#include <TRandom3.h>
+#include <TStopwatch.h>
+#include "STrackCutStudy.h"
+
+using namespace std;
+
+// global constants
+static const UInt_t NTrackDef(100000);
+static const UInt_t NHotTrack(16);
+static const UInt_t NRepeat(3);
+
+
+
+class STrackCutStudyBench {
+
+  public:
+
+    STrackCutStudyBench(const UInt_t nTracks, const UInt_t nThreads);
+    ~STrackCutStudyBench();
+
+    void BenchApplyCuts();
+    void BenchFills(const Bool_t isTruthFill, const vector<Int_t> &types, const Ssiz_t nFams, const Bool_t isHot);
+    void BenchNormalize();
+    void BenchSave();
+
+    // types to fill
+    vector<Int_t> GetTypes(const Bool_t isTruthType, const UInt_t nMax);
+
+  private:
+
+    // generated inputs (cold: spread over axes, hot: a handful of repeated tracks)
+    void GenerateInputs();
+
+    STrackCutStudy  *study;
+    UInt_t           nTrack;
+    UInt_t           nSaveThreads;
+    vector<Double_t> recoTrk[2];
+    vector<Double_t> trueTrk[2];
+    vector<Double_t> recoPhys[2];
+    vector<Double_t> truePhys[2];
+    vector<Bool_t>   isPrim;
+
+};  // end STrackCutStudyBench definition
+
+
+
+STrackCutStudyBench::STrackCutStudyBench(const UInt_t nTracks, const UInt_t nThreads) {
+
+  nTrack       = nTracks;
+  nSaveThreads = nThreads;
+
+  // study is set up with every type on, but without any input
+  study = new STrackCutStudy();
+  study -> SetBatchMode(true);
+  study -> SetStudyParameters(false, true, false, true, false, 0.2, 1.2);
+  study -> SetCutFlags(false, true, true, true, false, false, true);
+  study -> SetTrackCuts({2, 100}, {20, 100}, {-10., 10.}, {-20., 20.}, {-20., 20.}, {0., 10.});
+  study -> SetOutputParameters(ROOT::RCompressionSetting::EAlgorithm::kLZ4, 4, nSaveThreads);
+  study -> SetSparseOutput(true);
+  study -> SetDupGhost(true);
+  study -> InitHists();
+  study -> MakeCutText();
+  study -> evtMult = 500.;
+  GenerateInputs();
+
+}  // end ctor
+
+
+
+STrackCutStudyBench::~STrackCutStudyBench() {
+
+  delete study;
+
+}  // end dtor
+
+
+
+void STrackCutStudyBench::GenerateInputs() {
+
+  TRandom3 rando(1);
+  for (UInt_t iSet = 0; iSet < 2; iSet++) {
+    const Bool_t isHot   = (iSet == 1);
+    const UInt_t nToMake = isHot ? NHotTrack : nTrack;
+    recoTrk[iSet].resize(nToMake * NTrkVar);
+    trueTrk[iSet].resize(nToMake * NTrkVar);
+    recoPhys[iSet].resize(nToMake * NPhysVar);
+    truePhys[iSet].resize(nToMake * NPhysVar);
+    for (UInt_t iTrk = 0; iTrk < nToMake; iTrk++) {
+
+      // hot tracks only wander a little, so they land in a few bins
+      const Double_t spread = isHot ? 0.01 : 1.;
+      const Double_t ptTrue = isHot ? 5. + rando.Uniform(0., 0.05) : rando.Uniform(0.2, 20.);
+      Double_t *rTrk  = &recoTrk[iSet][iTrk * NTrkVar];
+      Double_t *tTrk  = &trueTrk[iSet][iTrk * NTrkVar];
+      Double_t *rPhys = &recoPhys[iSet][iTrk * NPhysVar];
+      Double_t *tPhys = &truePhys[iSet][iTrk * NPhysVar];
+
+      tTrk[STrackCutStudy::TRKVAR::VX]       = rando.Gaus(0., 0.01 * spread);
+      tTrk[STrackCutStudy::TRKVAR::VY]       = rando.Gaus(0., 0.01 * spread);
+      tTrk[STrackCutStudy::TRKVAR::VZ]       = rando.Gaus(0., 5. * spread);
+      tTrk[STrackCutStudy::TRKVAR::NMMS]     = 2;
+      tTrk[STrackCutStudy::TRKVAR::NMAP]     = 3;
+      tTrk[STrackCutStudy::TRKVAR::NINT]     = 4;
+      tTrk[STrackCutStudy::TRKVAR::NTPC]     = isHot ? 45 : rando.Integer(48);
+      tTrk[STrackCutStudy::TRKVAR::QUAL]     = 1.;
+      tTrk[STrackCutStudy::TRKVAR::DCAXY]    = 0.;
+      tTrk[STrackCutStudy::TRKVAR::DCAZ]     = 0.;
+      tTrk[STrackCutStudy::TRKVAR::DELDCAXY] = 0.;
+      tTrk[STrackCutStudy::TRKVAR::DELDCAZ]  = 0.;
+      tTrk[STrackCutStudy::TRKVAR::NCLUST]   = 57;
+      tTrk[STrackCutStudy::TRKVAR::AVGCLUST] = 2.;
+      for (Ssiz_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+        rTrk[iTrkVar] = tTrk[iTrkVar] * rando.Gaus(1., 0.05 * spread);
+      }
+      rTrk[STrackCutStudy::TRKVAR::DCAXY] = rando.Gaus(0., 20. * spread);
+      rTrk[STrackCutStudy::TRKVAR::DCAZ]  = rando.Gaus(0., 20. * spread);
+      rTrk[STrackCutStudy::TRKVAR::QUAL]  = rando.Exp(1. + spread);
+
+      tPhys[STrackCutStudy::PHYSVAR::PHI]    = rando.Uniform(-3.1 * spread, 3.1 * spread);
+      tPhys[STrackCutStudy::PHYSVAR::ETA]    = rando.Uniform(-1.1 * spread, 1.1 * spread);
+      tPhys[STrackCutStudy::PHYSVAR::PT]     = ptTrue;
+      tPhys[STrackCutStudy::PHYSVAR::DELPHI] = 0.;
+      tPhys[STrackCutStudy::PHYSVAR::DELETA] = 0.;
+      tPhys[STrackCutStudy::PHYSVAR::DELPT]  = 0.;
+      for (Ssiz_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+        rPhys[iPhysVar] = tPhys[iPhysVar] * rando.Gaus(1., 0.02 * spread);
+      }
+      rPhys[STrackCutStudy::PHYSVAR::DELPT] = rando.Exp(0.01 * spread);
+      if (!isHot) isPrim.push_back(rando.Uniform() < 0.9);
+    }
+  }
+  return;
+
+}  // end 'GenerateInputs()'
+
+
+
+vector<Int_t> STrackCutStudyBench::GetTypes(const Bool_t isTruthType, const UInt_t nMax) {
+
+  vector<Int_t> types;
+  for (Int_t iType = 0; (iType < NType) && (types.size() < nMax); iType++) {
+    if (study -> isTruth[iType] != isTruthType) continue;
+    types.push_back(iType);
+  }
+  return types;
+
+}  // end 'GetTypes(Bool_t, UInt_t)'
+
+
+
+void STrackCutStudyBench::BenchApplyCuts() {
+
+  const vector<Double_t> &trk = recoTrk[0];
+
+  UInt_t     nPass(0);
+  TStopwatch watch;
+  watch.Start();
+  for (UInt_t iRepeat = 0; iRepeat < NRepeat; iRepeat++) {
+    for (UInt_t iTrk = 0; iTrk < nTrack; iTrk++) {
+      const Double_t *vars = &trk[iTrk * NTrkVar];
+      if (study -> ApplyCuts(isPrim[iTrk], vars[STrackCutStudy::TRKVAR::NMAP], vars[STrackCutStudy::TRKVAR::NTPC], vars[STrackCutStudy::TRKVAR::VZ], vars[STrackCutStudy::TRKVAR::DCAXY], vars[STrackCutStudy::TRKVAR::DCAZ], vars[STrackCutStudy::TRKVAR::QUAL])) nPass++;
+    }
+  }
+  watch.Stop();
+
+  const Double_t nCalls = (Double_t) NRepeat * nTrack;
+  cout << "    ApplyCuts:       " << (1.e9 * watch.RealTime() / nCalls) << " ns/track ("
+       << nPass << " of " << nCalls << " passed)"
+       << endl;
+  return;
+
+}  // end 'BenchApplyCuts()'
+
+
+
+void STrackCutStudyBench::BenchFills(const Bool_t isTruthFill, const vector<Int_t> &types, const Ssiz_t nFams, const Bool_t isHot) {
+
+  // enable first 'nFams' families
+  for (Ssiz_t iFam = 0; iFam < NPlotFam; iFam++) {
+    study -> doFamFill[iFam] = (iFam < nFams);
+  }
+
+  // count fills per call
+  UInt_t nFillPerCall(0);
+  for (Ssiz_t iFam = 0; iFam < nFams; iFam++) {
+    const Bool_t isRecoOnly = ((iFam == STrackCutStudy::PLOTFAM::FAM_DIFF) || (iFam == STrackCutStudy::PLOTFAM::FAM_FRAC));
+    if (isTruthFill && isRecoOnly) continue;
+    for (Ssiz_t iTrkVar = 0; iTrkVar < NTrkVar; iTrkVar++) {
+      if (!isTruthFill || study -> trkVarHasTruVal[iTrkVar]) nFillPerCall++;
+    }
+    for (Ssiz_t iPhysVar = 0; iPhysVar < NPhysVar; iPhysVar++) {
+      if (!isTruthFill || study -> physVarHasTruVal[iPhysVar]) nFillPerCall++;
+    }
+  }
+
+  // hot: one type and a handful of tracks, cold: every type and track
+  const UInt_t iSet   = isHot ? 1 : 0;
+  const UInt_t nInput = isHot ? NHotTrack : nTrack;
+  const Ssiz_t nTypes = isHot ? 1 : types.size();
+
+  TStopwatch watch;
+  watch.Start();
+  for (UInt_t iRepeat = 0; iRepeat < NRepeat; iRepeat++) {
+    for (UInt_t iTrk = 0; iTrk < nTrack; iTrk++) {
+      const UInt_t iIn = iTrk % nInput;
+      for (Ssiz_t iType = 0; iType < nTypes; iType++) {
+        if (isTruthFill) {
+          study -> FillTruthHistograms(types[iType], &recoTrk[iSet][iIn * NTrkVar], &trueTrk[iSet][iIn * NTrkVar], &recoPhys[iSet][iIn * NPhysVar], &truePhys[iSet][iIn * NPhysVar]);
+        } else {
+          study -> FillTrackHistograms(types[iType], &recoTrk[iSet][iIn * NTrkVar], &trueTrk[iSet][iIn * NTrkVar], &recoPhys[iSet][iIn * NPhysVar], &truePhys[iSet][iIn * NPhysVar]);
+        }
+      }
+    }
+  }
+  watch.Stop();
+
+  const Double_t nTrkTot  = (Double_t) NRepeat * nTrack;
+  const Double_t nFillTot = nTrkTot * nTypes * nFillPerCall;
+  cout << "    " << (isTruthFill ? "FillTruth" : "FillTrack") << " (" << (isHot ? "hot" : "cold") << ", "
+       << nTypes << " types, " << nFams << " families): "
+       << (1.e9 * watch.RealTime() / nTrkTot) << " ns/track, "
+       << (nFillTot / watch.RealTime()) << " fills/s"
+       << endl;
+  return;
+
+}  // end 'BenchFills(Bool_t, vector<Int_t>&, Ssiz_t, Bool_t)'
+
+
+
+void STrackCutStudyBench::BenchNormalize() {
+
+  TStopwatch watch;
+  watch.Start();
+  study -> NormalizeHists();
+  watch.Stop();
+
+  const Double_t nHists = (Double_t) NType * (NTrkVar + NPhysVar) * NPlotFam;
+  cout << "    NormalizeHists:  " << watch.RealTime() << " s (" << (1.e9 * watch.RealTime() / nHists) << " ns/histogram)" << endl;
+  return;
+
+}  // end 'BenchNormalize()'
+
+
+
+void STrackCutStudyBench::BenchSave() {
+
+  const TString sOut("strackcutstudybench.root");
+  study -> fOut = new TFile(sOut.Data(), "recreate");
+  study -> fOut -> SetCompressionSettings(study -> compSettings);
+
+  TStopwatch watch;
+  watch.Start();
+  study -> SaveHists();
+  watch.Stop();
+
+  // merger closes output in parallel mode
+  if (study -> fOut) {
+    study -> fOut -> Close();
+    delete study -> fOut;
+    study -> fOut = NULL;
+  }
+  cout << "    SaveHists:       " << watch.RealTime() << " s (" << nSaveThreads << " threads)" << endl;
+  return;
+
+}  // end 'BenchSave()'
+
+
+
+int main(int argc, char *argv[]) {
+
+  // lower verbosity
+  gErrorIgnoreLevel = kError;
+
+  const UInt_t nTracks  = (argc > 1) ? atoi(argv[1]) : NTrackDef;
+  const UInt_t nThreads = (argc > 2) ? atoi(argv[2]) : 1;
+
+  cout << "\n  Setting up microbenchmarks (" << nTracks << " tracks)..." << endl;
+  STrackCutStudyBench bench(nTracks, nThreads);
+
+  cout << "  Running microbenchmarks:" << endl;
+  bench.BenchApplyCuts();
+
+  // fills: vary types and families, hot vs. cold
+  const vector<UInt_t> nTypesToTry = {1, 4, NType};
+  const vector<Ssiz_t> nFamsToTry  = {1, 3, NPlotFam};
+  for (const Bool_t isHot : {true, false}) {
+    for (const UInt_t nTypes : nTypesToTry) {
+      if (isHot && (nTypes > 1)) continue;
+      for (const Ssiz_t nFams : nFamsToTry) {
+        bench.BenchFills(false, bench.GetTypes(false, nTypes), nFams, isHot);
+      }
+    }
+    for (const Ssiz_t nFams : nFamsToTry) {
+      bench.BenchFills(true, bench.GetTypes(true, NType), nFams, isHot);
+    }
+  }
+
+  bench.BenchNormalize();
+  bench.BenchSave();
+
+  cout << "  Finished microbenchmarks!\n" << endl;
+  return 0;
+
+}  // end 'main(int, char*[])'
+
+// end ------------------------------------------------------------------------